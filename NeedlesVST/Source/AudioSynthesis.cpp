@@ -1,7 +1,449 @@
 #include "AudioSynthesis.h"
+#include <juce_core/juce_core.h>
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <memory>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define NEEDLES_CONVERT_SSE2 1
+ #include <immintrin.h>
+#else
+ #define NEEDLES_CONVERT_SSE2 0
+#endif
+
+#if NEEDLES_CONVERT_SSE2 && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+ #define NEEDLES_CONVERT_AVX2 1
+ #if defined(_MSC_VER) && !defined(__clang__)
+  #define NEEDLES_AVX2_TARGET
+ #else
+  #define NEEDLES_AVX2_TARGET __attribute__((target("avx2")))
+ #endif
+#else
+ #define NEEDLES_CONVERT_AVX2 0
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+ #define NEEDLES_CONVERT_NEON 1
+ #include <arm_neon.h>
+#else
+ #define NEEDLES_CONVERT_NEON 0
+#endif
+
+//==============================================================================
+ChannelWeights getChannelWeights(ConversionFormula formula)
+{
+    switch (formula)
+    {
+        case ConversionFormula::WeightedRGB:   return {0.2126f, 0.7152f, 0.0722f};  // ITU-R BT.709
+        case ConversionFormula::RedChannel:    return {1.0f, 0.0f, 0.0f};
+        case ConversionFormula::GreenChannel:  return {0.0f, 1.0f, 0.0f};
+        case ConversionFormula::BlueChannel:   return {0.0f, 0.0f, 1.0f};
+        case ConversionFormula::RGBAverage:
+        case ConversionFormula::MaxChannel:
+        case ConversionFormula::MinChannel:
+        default:                               return {1.0f / 3.0f, 1.0f / 3.0f, 1.0f / 3.0f};
+    }
+}
+
+//==============================================================================
+namespace
+{
+    // [0, 255] -> [-1.0, 1.0], as in RGB::toAudioChannel
+    constexpr float byteToAudioScale = 2.0f / 255.0f;
+    
+    //==============================================================================
+    /**
+     * Lookup tables of one formula, one per channel
+     * Weighted-sum formulas add all three; max/min formulas look the extreme
+     * channel byte up in the red table.
+     */
+    struct FormulaTables
+    {
+        ConversionTables::Table red, green, blue;
+    };
+    
+    constexpr int numFormulas = static_cast<int>(ConversionFormula::MinChannel) + 1;
+    
+    constexpr ConversionTables::Table zeroTable = ConversionTables::makeTable(0.0f, 0.0f);
+    
+    // Unity-gain tables, indexed by formula
+    constexpr std::array<FormulaTables, numFormulas> unityTables {{
+        {ConversionTables::averageFirst, ConversionTables::averageOther, ConversionTables::averageOther},
+        {ConversionTables::weightedRed, ConversionTables::weightedGreen, ConversionTables::weightedBlue},
+        {ConversionTables::byteToAudio, zeroTable, zeroTable},
+        {zeroTable, ConversionTables::byteToAudio, zeroTable},
+        {zeroTable, zeroTable, ConversionTables::byteToAudio},
+        {ConversionTables::byteToAudio, zeroTable, zeroTable},
+        {ConversionTables::byteToAudio, zeroTable, zeroTable}
+    }};
+    
+    size_t getTableIndex(ConversionFormula formula)
+    {
+        const int index = static_cast<int>(formula);
+        return static_cast<size_t>(index >= 0 && index < numFormulas ? index : 0);
+    }
+    
+    /**
+     * Arguments shared by all block conversion kernels
+     * Kernels convert a multiple of their vector width and return the count;
+     * the scalar kernel finishes the remainder.
+     */
+    struct ConversionBlock
+    {
+        const uint8_t* red;
+        const uint8_t* green;
+        const uint8_t* blue;
+        float* output;
+        int numSamples;
+        ChannelWeights weights;
+        const float* gainRamp;  // nullptr for constant gain
+        float gain;
+        const FormulaTables* tables;  // Gain folded in, or unity gain with a ramp
+    };
+    
+    enum class KernelMode
+    {
+        WeightedSum,   // Average, BT.709 and single-channel formulas
+        Maximum,
+        Minimum
+    };
+    
+    KernelMode getKernelMode(ConversionFormula formula)
+    {
+        if (formula == ConversionFormula::MaxChannel)
+            return KernelMode::Maximum;
+            
+        if (formula == ConversionFormula::MinChannel)
+            return KernelMode::Minimum;
+            
+        return KernelMode::WeightedSum;
+    }
+    
+    template <KernelMode mode>
+    inline float lookupSample(const FormulaTables& tables, uint8_t red, uint8_t green, uint8_t blue)
+    {
+        if constexpr (mode == KernelMode::WeightedSum)
+            return tables.red[red] + tables.green[green] + tables.blue[blue];
+        else if constexpr (mode == KernelMode::Maximum)
+            return tables.red[std::max({red, green, blue})];
+        else
+            return tables.red[std::min({red, green, blue})];
+    }
+    
+    inline float lookupSample(const FormulaTables& tables, KernelMode mode,
+                              uint8_t red, uint8_t green, uint8_t blue)
+    {
+        if (mode == KernelMode::WeightedSum)
+            return lookupSample<KernelMode::WeightedSum>(tables, red, green, blue);
+            
+        if (mode == KernelMode::Maximum)
+            return lookupSample<KernelMode::Maximum>(tables, red, green, blue);
+            
+        return lookupSample<KernelMode::Minimum>(tables, red, green, blue);
+    }
+    
+    //==============================================================================
+    // Kernels are instantiated for every mode and for constant or ramped gain,
+    // so their inner loops carry no per-sample branches
+    template <KernelMode mode, bool hasGainRamp>
+    void convertScalar(const ConversionBlock& block, int start)
+    {
+        for (int i = start; i < block.numSamples; ++i)
+        {
+            float sample = lookupSample<mode>(*block.tables, block.red[i], block.green[i], block.blue[i]);
+            
+            if constexpr (hasGainRamp)
+            {
+                sample *= block.gainRamp[i];
+            }
+            
+            block.output[i] = std::clamp(sample, -1.0f, 1.0f);
+        }
+    }
+    
+   #if NEEDLES_CONVERT_SSE2
+    //==============================================================================
+    inline __m128i loadFourBytesSSE2(const uint8_t* source)
+    {
+        int32_t packed;
+        std::memcpy(&packed, source, sizeof(packed));
+        return _mm_cvtsi32_si128(packed);
+    }
+    
+    inline __m128 widenBytesSSE2(__m128i bytes)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero));
+    }
+    
+    template <KernelMode mode, bool hasGainRamp>
+    int convertSSE2(const ConversionBlock& block)
+    {
+        const __m128 scale = _mm_set1_ps(byteToAudioScale);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 minusOne = _mm_set1_ps(-1.0f);
+        const __m128 weightRed = _mm_set1_ps(block.weights.red);
+        const __m128 weightGreen = _mm_set1_ps(block.weights.green);
+        const __m128 weightBlue = _mm_set1_ps(block.weights.blue);
+        const __m128 constantGain = _mm_set1_ps(block.gain);
+        
+        const int vectorEnd = block.numSamples & ~3;
+        
+        for (int i = 0; i < vectorEnd; i += 4)
+        {
+            const __m128i red = loadFourBytesSSE2(block.red + i);
+            const __m128i green = loadFourBytesSSE2(block.green + i);
+            const __m128i blue = loadFourBytesSSE2(block.blue + i);
+            
+            __m128 value;
+            
+            if constexpr (mode == KernelMode::WeightedSum)
+            {
+                value = _mm_add_ps(_mm_add_ps(_mm_mul_ps(widenBytesSSE2(red), weightRed),
+                                              _mm_mul_ps(widenBytesSSE2(green), weightGreen)),
+                                   _mm_mul_ps(widenBytesSSE2(blue), weightBlue));
+            }
+            else if constexpr (mode == KernelMode::Maximum)
+            {
+                value = widenBytesSSE2(_mm_max_epu8(red, _mm_max_epu8(green, blue)));
+            }
+            else
+            {
+                value = widenBytesSSE2(_mm_min_epu8(red, _mm_min_epu8(green, blue)));
+            }
+            
+            __m128 sample = _mm_sub_ps(_mm_mul_ps(value, scale), one);
+            sample = _mm_mul_ps(sample, hasGainRamp ? _mm_loadu_ps(block.gainRamp + i) : constantGain);
+            sample = _mm_min_ps(_mm_max_ps(sample, minusOne), one);
+            _mm_storeu_ps(block.output + i, sample);
+        }
+        
+        return vectorEnd;
+    }
+    
+    int splitChannelsSSE2(const uint8_t* red, const uint8_t* green, const uint8_t* blue,
+                          float* redOut, float* greenOut, float* blueOut, int numSamples)
+    {
+        const __m128 scale = _mm_set1_ps(byteToAudioScale);
+        const __m128 one = _mm_set1_ps(1.0f);
+        
+        const int vectorEnd = numSamples & ~3;
+        
+        for (int i = 0; i < vectorEnd; i += 4)
+        {
+            _mm_storeu_ps(redOut + i, _mm_sub_ps(_mm_mul_ps(widenBytesSSE2(loadFourBytesSSE2(red + i)), scale), one));
+            _mm_storeu_ps(greenOut + i, _mm_sub_ps(_mm_mul_ps(widenBytesSSE2(loadFourBytesSSE2(green + i)), scale), one));
+            _mm_storeu_ps(blueOut + i, _mm_sub_ps(_mm_mul_ps(widenBytesSSE2(loadFourBytesSSE2(blue + i)), scale), one));
+        }
+        
+        return vectorEnd;
+    }
+   #endif
+
+   #if NEEDLES_CONVERT_AVX2
+    //==============================================================================
+    NEEDLES_AVX2_TARGET inline __m128i loadEightBytesAVX2(const uint8_t* source)
+    {
+        return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source));
+    }
+    
+    NEEDLES_AVX2_TARGET inline __m256 widenBytesAVX2(__m128i bytes)
+    {
+        return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes));
+    }
+    
+    template <KernelMode mode, bool hasGainRamp>
+    NEEDLES_AVX2_TARGET int convertAVX2(const ConversionBlock& block)
+    {
+        const __m256 scale = _mm256_set1_ps(byteToAudioScale);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 minusOne = _mm256_set1_ps(-1.0f);
+        const __m256 weightRed = _mm256_set1_ps(block.weights.red);
+        const __m256 weightGreen = _mm256_set1_ps(block.weights.green);
+        const __m256 weightBlue = _mm256_set1_ps(block.weights.blue);
+        const __m256 constantGain = _mm256_set1_ps(block.gain);
+        
+        const int vectorEnd = block.numSamples & ~7;
+        
+        for (int i = 0; i < vectorEnd; i += 8)
+        {
+            const __m128i red = loadEightBytesAVX2(block.red + i);
+            const __m128i green = loadEightBytesAVX2(block.green + i);
+            const __m128i blue = loadEightBytesAVX2(block.blue + i);
+            
+            __m256 value;
+            
+            if constexpr (mode == KernelMode::WeightedSum)
+            {
+                value = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(widenBytesAVX2(red), weightRed),
+                                                    _mm256_mul_ps(widenBytesAVX2(green), weightGreen)),
+                                      _mm256_mul_ps(widenBytesAVX2(blue), weightBlue));
+            }
+            else if constexpr (mode == KernelMode::Maximum)
+            {
+                value = widenBytesAVX2(_mm_max_epu8(red, _mm_max_epu8(green, blue)));
+            }
+            else
+            {
+                value = widenBytesAVX2(_mm_min_epu8(red, _mm_min_epu8(green, blue)));
+            }
+            
+            __m256 sample = _mm256_sub_ps(_mm256_mul_ps(value, scale), one);
+            sample = _mm256_mul_ps(sample, hasGainRamp ? _mm256_loadu_ps(block.gainRamp + i) : constantGain);
+            sample = _mm256_min_ps(_mm256_max_ps(sample, minusOne), one);
+            _mm256_storeu_ps(block.output + i, sample);
+        }
+        
+        return vectorEnd;
+    }
+    
+    NEEDLES_AVX2_TARGET int splitChannelsAVX2(const uint8_t* red, const uint8_t* green, const uint8_t* blue,
+                                              float* redOut, float* greenOut, float* blueOut, int numSamples)
+    {
+        const __m256 scale = _mm256_set1_ps(byteToAudioScale);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        
+        const int vectorEnd = numSamples & ~7;
+        
+        for (int i = 0; i < vectorEnd; i += 8)
+        {
+            _mm256_storeu_ps(redOut + i, _mm256_sub_ps(_mm256_mul_ps(widenBytesAVX2(loadEightBytesAVX2(red + i)), scale), one));
+            _mm256_storeu_ps(greenOut + i, _mm256_sub_ps(_mm256_mul_ps(widenBytesAVX2(loadEightBytesAVX2(green + i)), scale), one));
+            _mm256_storeu_ps(blueOut + i, _mm256_sub_ps(_mm256_mul_ps(widenBytesAVX2(loadEightBytesAVX2(blue + i)), scale), one));
+        }
+        
+        return vectorEnd;
+    }
+   #endif
+
+   #if NEEDLES_CONVERT_NEON
+    //==============================================================================
+    template <KernelMode mode, bool hasGainRamp>
+    int convertNEON(const ConversionBlock& block)
+    {
+        const float32x4_t scale = vdupq_n_f32(byteToAudioScale);
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        const float32x4_t minusOne = vdupq_n_f32(-1.0f);
+        const float32x4_t constantGain = vdupq_n_f32(block.gain);
+        
+        auto widenLow = [](uint16x8_t values) { return vcvtq_f32_u32(vmovl_u16(vget_low_u16(values))); };
+        auto widenHigh = [](uint16x8_t values) { return vcvtq_f32_u32(vmovl_u16(vget_high_u16(values))); };
+        
+        auto finish = [&](float32x4_t value, int offset)
+        {
+            const float32x4_t gain = hasGainRamp ? vld1q_f32(block.gainRamp + offset) : constantGain;
+            float32x4_t sample = vmulq_f32(vsubq_f32(vmulq_f32(value, scale), one), gain);
+            sample = vminq_f32(vmaxq_f32(sample, minusOne), one);
+            vst1q_f32(block.output + offset, sample);
+        };
+        
+        const int vectorEnd = block.numSamples & ~7;
+        
+        for (int i = 0; i < vectorEnd; i += 8)
+        {
+            const uint8x8_t red = vld1_u8(block.red + i);
+            const uint8x8_t green = vld1_u8(block.green + i);
+            const uint8x8_t blue = vld1_u8(block.blue + i);
+            
+            if constexpr (mode == KernelMode::WeightedSum)
+            {
+                const uint16x8_t red16 = vmovl_u8(red);
+                const uint16x8_t green16 = vmovl_u8(green);
+                const uint16x8_t blue16 = vmovl_u8(blue);
+                
+                auto weightedSum = [&](float32x4_t r, float32x4_t g, float32x4_t b)
+                {
+                    float32x4_t sum = vmulq_n_f32(r, block.weights.red);
+                    sum = vmlaq_n_f32(sum, g, block.weights.green);
+                    return vmlaq_n_f32(sum, b, block.weights.blue);
+                };
+                
+                finish(weightedSum(widenLow(red16), widenLow(green16), widenLow(blue16)), i);
+                finish(weightedSum(widenHigh(red16), widenHigh(green16), widenHigh(blue16)), i + 4);
+            }
+            else
+            {
+                const uint8x8_t extreme = mode == KernelMode::Maximum
+                    ? vmax_u8(red, vmax_u8(green, blue))
+                    : vmin_u8(red, vmin_u8(green, blue));
+                const uint16x8_t extreme16 = vmovl_u8(extreme);
+                
+                finish(widenLow(extreme16), i);
+                finish(widenHigh(extreme16), i + 4);
+            }
+        }
+        
+        return vectorEnd;
+    }
+    
+    int splitChannelsNEON(const uint8_t* red, const uint8_t* green, const uint8_t* blue,
+                          float* redOut, float* greenOut, float* blueOut, int numSamples)
+    {
+        const float32x4_t scale = vdupq_n_f32(byteToAudioScale);
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        
+        auto split = [&](const uint8_t* source, float* destination)
+        {
+            const uint16x8_t values = vmovl_u8(vld1_u8(source));
+            vst1q_f32(destination, vsubq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(values))), scale), one));
+            vst1q_f32(destination + 4, vsubq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(values))), scale), one));
+        };
+        
+        const int vectorEnd = numSamples & ~7;
+        
+        for (int i = 0; i < vectorEnd; i += 8)
+        {
+            split(red + i, redOut + i);
+            split(green + i, greenOut + i);
+            split(blue + i, blueOut + i);
+        }
+        
+        return vectorEnd;
+    }
+   #endif
+
+    //==============================================================================
+    using ConvertKernel = void (*)(const ConversionBlock&);
+    
+    // Indexed by [KernelMode][hasGainRamp]
+    using KernelTable = std::array<std::array<ConvertKernel, 2>, 3>;
+    
+    template <KernelMode mode, bool hasGainRamp>
+    void convertDefault(const ConversionBlock& block)
+    {
+        int converted = 0;
+        
+       #if NEEDLES_CONVERT_SSE2
+        converted = convertSSE2<mode, hasGainRamp>(block);
+       #elif NEEDLES_CONVERT_NEON
+        converted = convertNEON<mode, hasGainRamp>(block);
+       #endif
+
+        convertScalar<mode, hasGainRamp>(block, converted);
+    }
+    
+    constexpr KernelTable defaultKernels {{
+        {{convertDefault<KernelMode::WeightedSum, false>, convertDefault<KernelMode::WeightedSum, true>}},
+        {{convertDefault<KernelMode::Maximum, false>, convertDefault<KernelMode::Maximum, true>}},
+        {{convertDefault<KernelMode::Minimum, false>, convertDefault<KernelMode::Minimum, true>}}
+    }};
+    
+   #if NEEDLES_CONVERT_AVX2
+    template <KernelMode mode, bool hasGainRamp>
+    void convertWithAVX2(const ConversionBlock& block)
+    {
+        convertScalar<mode, hasGainRamp>(block, convertAVX2<mode, hasGainRamp>(block));
+    }
+    
+    constexpr KernelTable avx2Kernels {{
+        {{convertWithAVX2<KernelMode::WeightedSum, false>, convertWithAVX2<KernelMode::WeightedSum, true>}},
+        {{convertWithAVX2<KernelMode::Maximum, false>, convertWithAVX2<KernelMode::Maximum, true>}},
+        {{convertWithAVX2<KernelMode::Minimum, false>, convertWithAVX2<KernelMode::Minimum, true>}}
+    }};
+   #endif
+}
+
 //==============================================================================
 /**
  * Concrete implementation of IAudioSynthesis for RGB-to-audio conversion
@@ -10,60 +452,85 @@ class AudioSynthesis : public IAudioSynthesis
 {
 private:
     float outputGain;
-
+    const KernelTable* kernels;  // Chosen once for the CPU
+    std::array<FormulaTables, numFormulas> gainTables;  // unityTables scaled by outputGain
+    
 public:
-    AudioSynthesis() : outputGain(1.0f) {}
+    AudioSynthesis() : outputGain(1.0f), kernels(&defaultKernels), gainTables(unityTables)
+    {
+       #if NEEDLES_CONVERT_AVX2
+        if (juce::SystemStats::hasAVX2())
+            kernels = &avx2Kernels;
+       #endif
+    }
     
     //==============================================================================
     float rgbToAudio(const RGB& rgb, ConversionFormula formula) override
     {
-        float audioSample = 0.0f;
-        
-        switch (formula)
+        // Gain is already folded into the tables; clamp to the valid range
+        const float audioSample = lookupSample(gainTables[getTableIndex(formula)], getKernelMode(formula),
+                                               rgb.red, rgb.green, rgb.blue);
+        return std::clamp(audioSample, -1.0f, 1.0f);
+    }
+    
+    //==============================================================================
+    void convertBlock(const uint8_t* red, const uint8_t* green, const uint8_t* blue,
+                      float* output, int numSamples, ConversionFormula formula,
+                      const float* gainRamp) const override
+    {
+        if (numSamples <= 0)
         {
-            case ConversionFormula::RGBAverage:
-                audioSample = rgb.toAudioSimple();
-                break;
-                
-            case ConversionFormula::WeightedRGB:
-                audioSample = rgb.toAudioWeighted();
-                break;
-                
-            case ConversionFormula::RedChannel:
-                audioSample = rgb.toAudioChannel(0);
-                break;
-                
-            case ConversionFormula::GreenChannel:
-                audioSample = rgb.toAudioChannel(1);
-                break;
-                
-            case ConversionFormula::BlueChannel:
-                audioSample = rgb.toAudioChannel(2);
-                break;
-                
-            case ConversionFormula::MaxChannel:
-                audioSample = convertMaxChannel(rgb);
-                break;
-                
-            case ConversionFormula::MinChannel:
-                audioSample = convertMinChannel(rgb);
-                break;
-                
-            default:
-                audioSample = rgb.toAudioSimple();
-                break;
+            return;
         }
         
-        // Apply output gain and ensure we stay in valid range
-        audioSample *= outputGain;
-        return std::clamp(audioSample, -1.0f, 1.0f);
+        const size_t tableIndex = getTableIndex(formula);
+        const FormulaTables* tables = gainRamp != nullptr ? &unityTables[tableIndex] : &gainTables[tableIndex];
+        const ConversionBlock block {red, green, blue, output, numSamples,
+                                     getChannelWeights(formula), gainRamp, outputGain, tables};
+        const size_t mode = static_cast<size_t>(getKernelMode(formula));
+        
+        // One branch-free kernel per block
+        (*kernels)[mode][gainRamp != nullptr ? 1 : 0](block);
+    }
+    
+    //==============================================================================
+    void convertChannels(const uint8_t* red, const uint8_t* green, const uint8_t* blue,
+                         float* redOutput, float* greenOutput, float* blueOutput,
+                         int numSamples) const override
+    {
+        int converted = 0;
+        
+       #if NEEDLES_CONVERT_AVX2
+        if (kernels == &avx2Kernels)
+            converted = splitChannelsAVX2(red, green, blue, redOutput, greenOutput, blueOutput, numSamples);
+        else
+       #endif
+       #if NEEDLES_CONVERT_SSE2
+        converted = splitChannelsSSE2(red, green, blue, redOutput, greenOutput, blueOutput, numSamples);
+       #elif NEEDLES_CONVERT_NEON
+        converted = splitChannelsNEON(red, green, blue, redOutput, greenOutput, blueOutput, numSamples);
+       #endif
+        
+        // Unit gain keeps every sample inside [-1.0, 1.0], so no clamp is needed
+        for (int i = converted; i < numSamples; ++i)
+        {
+            redOutput[i] = ConversionTables::byteToAudio[red[i]];
+            greenOutput[i] = ConversionTables::byteToAudio[green[i]];
+            blueOutput[i] = ConversionTables::byteToAudio[blue[i]];
+        }
     }
     
     //==============================================================================
     void setGain(float gain) override
     {
         // Clamp gain to reasonable range (0.0 to 2.0 as per data model)
-        outputGain = std::clamp(gain, 0.0f, 2.0f);
+        const float newGain = std::clamp(gain, 0.0f, 2.0f);
+        
+        if (newGain != outputGain)
+        {
+            outputGain = newGain;
+            foldGain();
+        }
     }
     
     //==============================================================================
@@ -74,17 +541,20 @@ public:
     
 private:
     //==============================================================================
-    float convertMaxChannel(const RGB& rgb) const
+    void foldGain()
     {
-        uint8_t maxValue = std::max({rgb.red, rgb.green, rgb.blue});
-        return (static_cast<float>(maxValue) / 255.0f) * 2.0f - 1.0f;
-    }
-    
-    //==============================================================================
-    float convertMinChannel(const RGB& rgb) const
-    {
-        uint8_t minValue = std::min({rgb.red, rgb.green, rgb.blue});
-        return (static_cast<float>(minValue) / 255.0f) * 2.0f - 1.0f;
+        for (size_t formula = 0; formula < unityTables.size(); ++formula)
+        {
+            const FormulaTables& unity = unityTables[formula];
+            FormulaTables& scaled = gainTables[formula];
+            
+            for (size_t value = 0; value < unity.red.size(); ++value)
+            {
+                scaled.red[value] = unity.red[value] * outputGain;
+                scaled.green[value] = unity.green[value] * outputGain;
+                scaled.blue[value] = unity.blue[value] * outputGain;
+            }
+        }
     }
 };
 
@@ -93,4 +563,4 @@ private:
 std::unique_ptr<IAudioSynthesis> createAudioSynthesis()
 {
     return std::make_unique<AudioSynthesis>();
-}
\ No newline at end of file
+}
@@ -1,8 +1,48 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <memory>
 
+//==============================================================================
+/**
+ * Byte-to-sample lookup tables, generated at compile time
+ * 
+ * Each table maps a channel byte straight to its contribution to the audio
+ * sample, so a conversion is one load per channel and no division. The -1.0
+ * offset of the [0, 255] -> [-1.0, 1.0] mapping is folded into one table of
+ * each formula, so summing a formula's tables gives the finished sample.
+ */
+namespace ConversionTables
+{
+    using Table = std::array<float, 256>;
+    
+    /**
+     * Build the table of value * scale + offset for every byte value
+     */
+    constexpr Table makeTable(float scale, float offset)
+    {
+        Table table {};
+        
+        for (int value = 0; value < 256; ++value)
+            table[static_cast<size_t>(value)] = static_cast<float>(value) * scale + offset;
+            
+        return table;
+    }
+    
+    // Single channel, [0, 255] -> [-1.0, 1.0]
+    inline constexpr Table byteToAudio = makeTable(2.0f / 255.0f, -1.0f);
+    
+    // Channel contributions to the average
+    inline constexpr Table averageFirst = makeTable(2.0f / (3.0f * 255.0f), -1.0f);
+    inline constexpr Table averageOther = makeTable(2.0f / (3.0f * 255.0f), 0.0f);
+    
+    // Channel contributions to ITU-R BT.709 luminance
+    inline constexpr Table weightedRed = makeTable(0.2126f * 2.0f / 255.0f, -1.0f);
+    inline constexpr Table weightedGreen = makeTable(0.7152f * 2.0f / 255.0f, 0.0f);
+    inline constexpr Table weightedBlue = makeTable(0.0722f * 2.0f / 255.0f, 0.0f);
+}
+
 //==============================================================================
 /**
  * RGB color data structure for image-to-audio conversion
@@ -23,8 +63,9 @@ struct RGB
      */
     float toAudioSimple() const
     {
-        float avg = (static_cast<float>(red) + green + blue) / (3.0f * 255.0f);
-        return avg * 2.0f - 1.0f; // Convert [0,1] to [-1,1]
+        return ConversionTables::averageFirst[red]
+             + ConversionTables::averageOther[green]
+             + ConversionTables::averageOther[blue];
     }
     
     /**
@@ -34,8 +75,9 @@ struct RGB
     float toAudioWeighted() const
     {
         // ITU-R BT.709 luminance weights
-        float luminance = (0.2126f * red + 0.7152f * green + 0.0722f * blue) / 255.0f;
-        return luminance * 2.0f - 1.0f;
+        return ConversionTables::weightedRed[red]
+             + ConversionTables::weightedGreen[green]
+             + ConversionTables::weightedBlue[blue];
     }
     
     /**
@@ -46,7 +88,7 @@ struct RGB
     float toAudioChannel(int channel) const
     {
         uint8_t value = (channel == 0) ? red : (channel == 1) ? green : blue;
-        return (static_cast<float>(value) / 255.0f) * 2.0f - 1.0f;
+        return ConversionTables::byteToAudio[value];
     }
     
     bool operator==(const RGB& other) const
@@ -70,6 +112,24 @@ enum class ConversionFormula
     MinChannel          // Minimum of R, G, B
 };
 
+//==============================================================================
+/**
+ * Contribution of each colour channel to a conversion formula
+ */
+struct ChannelWeights
+{
+    float red, green, blue;
+};
+
+/**
+ * Get the channel weights of a conversion formula
+ * Linear formulas return their exact weights; the nonlinear max/min formulas
+ * weight all channels equally.
+ * @param formula Conversion formula
+ * @return Channel weights summing to 1.0
+ */
+ChannelWeights getChannelWeights(ConversionFormula formula);
+
 //==============================================================================
 /**
  * Audio synthesis interface for converting image data to audio samples
@@ -87,8 +147,44 @@ public:
      */
     virtual float rgbToAudio(const RGB& rgb, ConversionFormula formula = ConversionFormula::RGBAverage) = 0;
     
+    /**
+     * Convert a block of planar RGB data to audio samples in a single pass
+     * Gain and the [-1.0, 1.0] clamp are applied in the same pass. Uses SSE2, AVX2
+     * or NEON kernels where available.
+     * @param red Array of red values
+     * @param green Array of green values
+     * @param blue Array of blue values
+     * @param output Array receiving the audio samples
+     * @param numSamples Number of samples to convert
+     * @param formula Conversion algorithm to use
+     * @param gainRamp Optional per-sample gain; the gain set by setGain is used if nullptr
+     */
+    virtual void convertBlock(const uint8_t* red, const uint8_t* green, const uint8_t* blue,
+                              float* output, int numSamples,
+                              ConversionFormula formula = ConversionFormula::RGBAverage,
+                              const float* gainRamp = nullptr) const = 0;
+    
+    /**
+     * Convert each channel of a block of planar RGB data to its own audio signal
+     * All three channels are mapped [0, 255] -> [-1.0, 1.0] at unit gain in one
+     * pass over the input, using the same vector kernels as convertBlock.
+     * @param red Array of red values
+     * @param green Array of green values
+     * @param blue Array of blue values
+     * @param redOutput Array receiving the red signal
+     * @param greenOutput Array receiving the green signal
+     * @param blueOutput Array receiving the blue signal
+     * @param numSamples Number of samples to convert
+     */
+    virtual void convertChannels(const uint8_t* red, const uint8_t* green, const uint8_t* blue,
+                                 float* redOutput, float* greenOutput, float* blueOutput,
+                                 int numSamples) const = 0;
+    
     /**
      * Set output gain for audio synthesis
+     * The gain is folded into the conversion tables, so changing it costs a
+     * table rebuild; setting the same gain again is free. Per-sample gain
+     * belongs in convertBlock's gain ramp.
      * @param gain Gain multiplier (0.0 to 2.0)
      */
     virtual void setGain(float gain) = 0;
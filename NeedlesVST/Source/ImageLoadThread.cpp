@@ -0,0 +1,318 @@
+/*
+ * ImageLoadThread.cpp - Background image loading pipeline implementation
+ */
+
+#include "ImageLoadThread.h"
+#include "ImpulseResponseBuilder.h"
+
+//==============================================================================
+ImageLoadThread::ImageLoadThread(ImagePublisher& publisher)
+    : juce::Thread("Needles Image Loader")
+    , imagePublisher(publisher)
+{
+    startThread();
+}
+
+ImageLoadThread::~ImageLoadThread()
+{
+    cancelPendingUpdate();
+    signalThreadShouldExit();
+    notify();
+    stopThread(5000);
+}
+
+//==============================================================================
+void ImageLoadThread::requestLoad(const juce::String& filePath)
+{
+    {
+        const juce::ScopedLock lock(requestLock);
+        pendingPath = filePath;
+        hasPendingRequest = true;
+        
+        // Any load still running sees the new id and abandons its work
+        ++latestRequestId;
+    }
+    
+    notify();
+}
+
+void ImageLoadThread::cancelPendingLoad()
+{
+    const juce::ScopedLock lock(requestLock);
+    hasPendingRequest = false;
+    ++latestRequestId;
+}
+
+void ImageLoadThread::setSampleCacheOptions(const SampleCacheOptions& options)
+{
+    const juce::ScopedLock lock(requestLock);
+    sampleCacheOptions = options;
+}
+
+bool ImageLoadThread::isSuperseded(uint64_t requestId) const
+{
+    return threadShouldExit() || latestRequestId.load() != requestId;
+}
+
+//==============================================================================
+void ImageLoadThread::run()
+{
+    while (!threadShouldExit())
+    {
+        wait(-1);
+        
+        juce::String filePath;
+        uint64_t requestId = 0;
+        SampleCacheOptions cacheOptions;
+        
+        {
+            const juce::ScopedLock lock(requestLock);
+            if (!hasPendingRequest)
+            {
+                continue;
+            }
+            
+            filePath = pendingPath;
+            cacheOptions = sampleCacheOptions;
+            requestId = latestRequestId.load();
+            hasPendingRequest = false;
+        }
+        
+        LoadObserver observer;
+        observer.shouldCancel = [this, requestId] { return isSuperseded(requestId); };
+        observer.onProgress = [this, requestId, filePath](float progress)
+        {
+            postProgress(requestId, filePath, progress);
+        };
+        
+        ImageLoadStatus status;
+        status.filePath = filePath;
+        
+        auto snapshot = buildSnapshot(filePath, observer, status.errorMessage, cacheOptions);
+        
+        // A superseded load is dropped silently; the newer request is already queued
+        if (isSuperseded(requestId))
+        {
+            continue;
+        }
+        
+        if (snapshot != nullptr)
+        {
+            status.success = true;
+            status.dimensions = snapshot->dimensions;
+            status.image = snapshot->loader->getImage();
+            imagePublisher.publish(std::move(snapshot));
+        }
+        
+        postCompletion(std::move(status));
+    }
+}
+
+//==============================================================================
+void ImageLoadThread::postProgress(uint64_t requestId, const juce::String& filePath, float progress)
+{
+    if (isSuperseded(requestId))
+    {
+        return;
+    }
+    
+    {
+        const juce::ScopedLock lock(notificationLock);
+        progressPath = filePath;
+        progressValue = progress;
+        hasProgress = true;
+    }
+    
+    triggerAsyncUpdate();
+}
+
+void ImageLoadThread::postCompletion(ImageLoadStatus status)
+{
+    {
+        const juce::ScopedLock lock(notificationLock);
+        completedStatus = std::move(status);
+        hasCompletion = true;
+        hasProgress = false;
+    }
+    
+    triggerAsyncUpdate();
+}
+
+void ImageLoadThread::handleAsyncUpdate()
+{
+    juce::String path;
+    float progress = 0.0f;
+    bool deliverProgress = false;
+    ImageLoadStatus status;
+    bool deliverCompletion = false;
+    
+    {
+        const juce::ScopedLock lock(notificationLock);
+        
+        if (hasProgress)
+        {
+            path = progressPath;
+            progress = progressValue;
+            deliverProgress = true;
+            hasProgress = false;
+        }
+        
+        if (hasCompletion)
+        {
+            status = std::move(completedStatus);
+            completedStatus = {};
+            deliverCompletion = true;
+            hasCompletion = false;
+        }
+    }
+    
+    if (deliverProgress && onProgress)
+        onProgress(path, progress);
+    
+    if (deliverCompletion && onComplete)
+        onComplete(status);
+}
+
+//==============================================================================
+std::unique_ptr<ImageSnapshot> ImageLoadThread::buildSnapshot(const juce::String& filePath,
+                                                             const LoadObserver& observer,
+                                                             juce::String& errorMessage,
+                                                             const SampleCacheOptions& cacheOptions)
+{
+    // Validate file path
+    if (filePath.isEmpty())
+    {
+        errorMessage = "Empty file path provided";
+        DBG("Needles: Error - " << errorMessage);
+        return nullptr;
+    }
+    
+    // Check if file exists
+    juce::File imageFile(filePath);
+    if (!imageFile.existsAsFile())
+    {
+        errorMessage = "File does not exist: " + filePath;
+        DBG("Needles: Error - " << errorMessage);
+        return nullptr;
+    }
+    
+    // Check file size (prevent loading extremely large files)
+    auto fileSize = imageFile.getSize();
+    const int64_t maxFileSize = 100 * 1024 * 1024; // 100MB limit
+    if (fileSize > maxFileSize)
+    {
+        errorMessage = "File too large: " + juce::String(fileSize / (1024 * 1024)) + "MB (max 100MB)";
+        DBG("Needles: Error - " << errorMessage);
+        return nullptr;
+    }
+    
+    // Check file extension for supported formats
+    auto extension = imageFile.getFileExtension().toLowerCase();
+    juce::StringArray supportedFormats = { ".jpg", ".jpeg", ".png", ".gif", ".bmp" };
+    if (!supportedFormats.contains(extension))
+    {
+        errorMessage = "Unsupported file format: " + extension + 
+                          " (supported: " + supportedFormats.joinIntoString(", ") + ")";
+        DBG("Needles: Error - " << errorMessage);
+        return nullptr;
+    }
+    
+    if (observer.isCancelled())
+    {
+        return nullptr;
+    }
+    
+    observer.reportProgress(0.05f);
+    
+    // Decode into a fresh loader; the audio thread keeps playing the current image
+    // until the finished snapshot is published
+    auto snapshot = std::make_unique<ImageSnapshot>();
+    snapshot->loader = createImageLoader();
+    snapshot->loader->setSampleCacheOptions(cacheOptions);
+    
+    LoadObserver loaderObserver;
+    loaderObserver.shouldCancel = observer.shouldCancel;
+    loaderObserver.onProgress = [&observer](float progress)
+    {
+        // Decoding and preparation cover most of the overall load
+        observer.reportProgress(0.05f + progress * 0.9f);
+    };
+    
+    LoadResult result = snapshot->loader->loadImage(filePath.toStdString(), loaderObserver);
+    
+    // Abandoned part way through, which is not an error
+    if (observer.isCancelled())
+    {
+        return nullptr;
+    }
+    
+    if (result.success)
+    {
+        // Verify image dimensions are valid
+        auto dimensions = snapshot->loader->getDimensions();
+        if (dimensions.width <= 0 || dimensions.height <= 0)
+        {
+            errorMessage = "Invalid image dimensions: " + 
+                              juce::String(dimensions.width) + "x" + juce::String(dimensions.height);
+            DBG("Needles: Error - " << errorMessage);
+            return nullptr;
+        }
+        
+        // Check minimum image size
+        if (dimensions.width < 2 || dimensions.height < 2)
+        {
+            errorMessage = "Image too small for audio synthesis (minimum 2x2 pixels): " + 
+                              juce::String(dimensions.width) + "x" + juce::String(dimensions.height);
+            DBG("Needles: Error - " << errorMessage);
+            return nullptr;
+        }
+        
+        snapshot->dimensions = dimensions;
+        snapshot->filePath = filePath.toStdString();
+        
+        // Scan paths depend only on the dimensions, so compile them here rather
+        // than on the audio thread; large tables wait until a pattern needs them
+        snapshot->scanPaths.compile(dimensions, true);
+        
+        // Impulse responses are read along the same paths the needles play
+        if (auto* impulseResponses = snapshot->loader->getImpulseResponseBuilder())
+        {
+            impulseResponses->setScanPaths(&snapshot->scanPaths);
+        }
+        
+        // Clear any previous errors
+        errorMessage.clear();
+        
+        DBG("Needles: Image prepared - " << filePath << " (" << dimensions.width << "x" << dimensions.height << ")");
+        return snapshot;
+    }
+    else
+    {
+        // Handle various error types from ImageLoader
+        errorMessage = "Failed to load image";
+        if (!result.errorMessage.empty())
+        {
+            errorMessage += ": " + juce::String(result.errorMessage.c_str());
+        }
+        
+        // Add user-friendly error interpretation
+        if (result.errorMessage.find("format") != std::string::npos || 
+            result.errorMessage.find("decode") != std::string::npos ||
+            result.errorMessage.find("invalid") != std::string::npos)
+        {
+            errorMessage += " (The file may be corrupted or in an unsupported format)";
+        }
+        else if (result.errorMessage.find("memory") != std::string::npos)
+        {
+            errorMessage += " (Insufficient memory to load image)";
+        }
+        else if (result.errorMessage.find("access") != std::string::npos ||
+                 result.errorMessage.find("permission") != std::string::npos)
+        {
+            errorMessage += " (File access denied)";
+        }
+        
+        DBG("Needles: " << errorMessage);
+        return nullptr;
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ * ImageLoadThread.h - Background image loading pipeline
+ *
+ * Validates, decodes and prepares images on a dedicated thread so the message
+ * thread never blocks on file I/O or decoding. A newer load request supersedes
+ * one still in progress, and progress/completion notifications are delivered
+ * on the message thread.
+ */
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#include "ImagePublisher.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+//==============================================================================
+/**
+ * Outcome of a background image load, delivered on the message thread
+ */
+struct ImageLoadStatus
+{
+    juce::String filePath;
+    bool success {false};
+    juce::String errorMessage;
+    Dimensions dimensions;
+    juce::Image image;  // Decoded image for display, invalid on failure
+};
+
+//==============================================================================
+/**
+ * Dedicated loader thread that publishes finished images through ImagePublisher
+ */
+class ImageLoadThread : private juce::Thread
+                      , private juce::AsyncUpdater
+{
+public:
+    explicit ImageLoadThread(ImagePublisher& publisher);
+    ~ImageLoadThread() override;
+
+    /**
+     * Queue an image for loading, superseding any load still in progress
+     * @param filePath Absolute path to image file
+     */
+    void requestLoad(const juce::String& filePath);
+
+    /**
+     * Abandon any pending or in-progress load without publishing it
+     */
+    void cancelPendingLoad();
+
+    /**
+     * Set the sample cache settings used by loads requested from now on
+     * @param options Memory budget and formula to preload
+     */
+    void setSampleCacheOptions(const SampleCacheOptions& options);
+
+    /**
+     * Validate, decode and prepare an image snapshot on the calling thread
+     * @param filePath Absolute path to image file
+     * @param observer Progress and cancellation hooks
+     * @param errorMessage Receives a user-facing error on failure
+     * @param cacheOptions Sample cache settings for the new loader
+     * @return Prepared snapshot, or nullptr on failure or cancellation
+     */
+    static std::unique_ptr<ImageSnapshot> buildSnapshot(const juce::String& filePath,
+                                                        const LoadObserver& observer,
+                                                        juce::String& errorMessage,
+                                                        const SampleCacheOptions& cacheOptions = {});
+
+    // Notifications, always invoked on the message thread
+    std::function<void(const juce::String& filePath, float progress)> onProgress;
+    std::function<void(const ImageLoadStatus& status)> onComplete;
+
+private:
+    //==============================================================================
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    void postProgress(uint64_t requestId, const juce::String& filePath, float progress);
+    void postCompletion(ImageLoadStatus status);
+    bool isSuperseded(uint64_t requestId) const;
+
+    ImagePublisher& imagePublisher;
+
+    // Request hand-over from the message thread
+    juce::CriticalSection requestLock;
+    juce::String pendingPath;
+    bool hasPendingRequest {false};
+    SampleCacheOptions sampleCacheOptions;
+    std::atomic<uint64_t> latestRequestId {0};
+
+    // Notification hand-over to the message thread
+    juce::CriticalSection notificationLock;
+    juce::String progressPath;
+    float progressValue {0.0f};
+    bool hasProgress {false};
+    ImageLoadStatus completedStatus;
+    bool hasCompletion {false};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ImageLoadThread)
+};
@@ -1,23 +1,169 @@
 #include "ImageLoader.h"
+#include "ImagePyramid.h"
+#include "SamplePlaneCache.h"
+#include "SpectrogramRenderer.h"
+#include "ImpulseResponseBuilder.h"
+#include "WavetableBank.h"
 #include <juce_graphics/juce_graphics.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    //==============================================================================
+    /**
+     * Heap buffer whose first element is aligned for vector loads
+     */
+    template <typename T>
+    class AlignedBuffer
+    {
+    public:
+        void allocate(size_t numElements, size_t alignment)
+        {
+            // Value-initialised so row padding reads as zero
+            storage.reset(new uint8_t[numElements * sizeof(T) + alignment]());
+            
+            auto address = reinterpret_cast<uintptr_t>(storage.get());
+            auto alignedAddress = (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+            data = reinterpret_cast<T*>(alignedAddress);
+        }
+        
+        void clear()
+        {
+            storage.reset();
+            data = nullptr;
+        }
+        
+        T* get() const
+        {
+            return data;
+        }
+        
+    private:
+        std::unique_ptr<uint8_t[]> storage;
+        T* data {nullptr};
+    };
+    
+    //==============================================================================
+    /**
+     * Split [0, numItems) into contiguous ranges and run them on worker threads
+     */
+    template <typename Function>
+    void parallelForRanges(int numItems, Function&& function)
+    {
+        const int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+        const int numThreads = juce::jlimit(1, 8, std::min(hardwareThreads, numItems / 64));
+        
+        if (numThreads <= 1)
+        {
+            function(0, numItems);
+            return;
+        }
+        
+        std::vector<std::thread> workers;
+        workers.reserve(static_cast<size_t>(numThreads));
+        
+        const int itemsPerThread = (numItems + numThreads - 1) / numThreads;
+        
+        for (int start = 0; start < numItems; start += itemsPerThread)
+        {
+            const int end = std::min(numItems, start + itemsPerThread);
+            workers.emplace_back([&function, start, end] { function(start, end); });
+        }
+        
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
+}
 
 //==============================================================================
 /**
  * Concrete implementation of IImageLoader using JUCE::Image
+ * 
+ * The decoded image is converted once into planar R/G/B(/A) uint8 planes, and
+ * all pixel reads go through those planes rather than juce::Image::getPixelAt.
  */
-class ImageLoader : public IImageLoader
+class ImageLoader final : public IImageLoader
 {
 private:
     juce::Image image;
     std::string currentFilePath;
     Dimensions dimensions;
     bool imageLoaded;
+    
+    // Planar pixel store
+    AlignedBuffer<uint8_t> redPlane, greenPlane, bluePlane, alphaPlane;
+    PixelPlanes planes;
+    
+    // Summed-area table, (width + 1) x (height + 1) entries of interleaved R/G/B sums.
+    // 32 bits per channel suffices: 4095 * 4095 * 255 < 2^32, and unsigned
+    // wrap-around keeps the four-tap differences exact regardless.
+    // Entries are stored in 8 x 8 tiles, row-major within a tile, so vertical
+    // and space-filling-curve scans read neighbouring cache lines instead of
+    // striding a whole table row per sample.
+    static constexpr int areaTableChannels = 3;
+    static constexpr int areaTableTileShift = 3;
+    static constexpr int areaTableTileMask = (1 << areaTableTileShift) - 1;
+    std::vector<uint32_t> areaTable;
+    int areaTableTilesPerRow {0};
+    
+    // Gaussian pyramid, built by the helper on the first Gaussian read. Readers
+    // only touch the pyramid once pyramidReady has been set.
+    static constexpr int maxCircularBands = 8;
+    ImagePyramid pyramid;
+    std::atomic<bool> pyramidReady {false};
+    
+    // Per-formula sample tables. The preload formula is built during the load;
+    // others are built by the helper when the audio thread first asks for them.
+    SampleCacheOptions sampleCacheOptions;
+    SamplePlaneCache sampleCache;
+    
+    // Row and column wavetables, built by the helper on the first wavetable read.
+    // Readers only touch the banks once wavetablesReady has been set.
+    std::array<WavetableBank, 2> wavetables;
+    std::atomic<bool> wavetablesReady {false};
+    
+    // Spectrogram resynthesis; its worker is started on the first read
+    std::unique_ptr<SpectrogramRenderer> spectrogram;
+    
+    // Impulse responses for input convolution; the worker is started on the first request
+    std::unique_ptr<ImpulseResponseBuilder> impulseResponses;
+    
+    // One helper thread per image sleeps on helperWake until a reader needs one of
+    // the above. Requests are raised without blocking from the audio thread; each
+    // is signalled once, and only sample cache requests are cleared when taken.
+    static constexpr uint32_t pyramidRequest = 1u << 0;
+    static constexpr uint32_t sampleCacheRequest = 1u << 1;
+    static constexpr uint32_t wavetableRequest = 1u << 2;
+    static constexpr uint32_t spectrogramRequest = 1u << 3;
+    static constexpr uint32_t impulseResponseRequest = 1u << 4;
+    std::thread helper;
+    juce::WaitableEvent helperWake;
+    mutable std::atomic<uint32_t> helperRequests {0};
+    std::atomic<bool> helperCancelled {false};
 
 public:
-    ImageLoader() : dimensions({0, 0}), imageLoaded(false) {}
+    ImageLoader()
+        : dimensions({0, 0}), imageLoaded(false), spectrogram(std::make_unique<SpectrogramRenderer>()),
+          impulseResponses(std::make_unique<ImpulseResponseBuilder>(*this, [this] { raiseHelperRequest(impulseResponseRequest); }))
+    {
+    }
+    
+    ~ImageLoader() override
+    {
+        stopHelper();
+        impulseResponses->stopWorker();
+        spectrogram->stopWorker();
+    }
     
     //==============================================================================
-    LoadResult loadImage(const std::string& filePath) override
+    LoadResult loadImage(const std::string& filePath, const LoadObserver& observer = {}) override
     {
         try
         {
@@ -46,6 +192,8 @@ public:
                 return LoadResult(false, "Unsupported file format: " + extension.toStdString());
             }
             
+            observer.reportProgress(0.0f);
+            
             // Attempt to load image using JUCE with error handling
             try
             {
@@ -65,6 +213,14 @@ public:
                 return LoadResult(false, "Failed to load image or unsupported format: " + filePath);
             }
             
+            if (observer.isCancelled())
+            {
+                clearImage();
+                return LoadResult(false, "Load cancelled: " + filePath);
+            }
+            
+            observer.reportProgress(0.8f);
+            
             // Validate image dimensions (must be > 0 and < 4096 per data model)
             int width = image.getWidth();
             int height = image.getHeight();
@@ -81,11 +237,41 @@ public:
                 return LoadResult(false, "Image dimensions too large (>=4096): " + std::to_string(width) + "x" + std::to_string(height));
             }
             
+            // Convert to the planar store used by all pixel reads
+            if (!buildPixelPlanes(observer))
+            {
+                clearImage();
+                return LoadResult(false, "Load cancelled: " + filePath);
+            }
+            
+            observer.reportProgress(0.85f);
+            
+            if (!buildAreaTable(observer))
+            {
+                clearImage();
+                return LoadResult(false, "Load cancelled: " + filePath);
+            }
+            
+            observer.reportProgress(0.9f);
+            
+            if (!prepareSampleCache(observer))
+            {
+                clearImage();
+                return LoadResult(false, "Load cancelled: " + filePath);
+            }
+            
+            observer.reportProgress(0.95f);
+            
             // Update state
             currentFilePath = filePath;
             dimensions = {width, height};
             imageLoaded = true;
             
+            // Pyramid, wavetables and workers wait until a mode first reads them
+            spectrogram->prepare(planes);
+            startHelper();
+            
+            observer.reportProgress(1.0f);
             return LoadResult(true, "Image loaded successfully");
         }
         catch (const std::exception& e)
@@ -118,11 +304,11 @@ public:
         float wx = x - x1;
         float wy = y - y1;
         
-        // Get four corner pixels
-        auto pixel11 = image.getPixelAt(x1, y1);
-        auto pixel12 = image.getPixelAt(x1, y2);
-        auto pixel21 = image.getPixelAt(x2, y1);
-        auto pixel22 = image.getPixelAt(x2, y2);
+        // Offsets of the four corner pixels
+        const size_t offset11 = planes.offsetOf(x1, y1);
+        const size_t offset12 = planes.offsetOf(x1, y2);
+        const size_t offset21 = planes.offsetOf(x2, y1);
+        const size_t offset22 = planes.offsetOf(x2, y2);
         
         // Bilinear interpolation
         auto interpolateComponent = [wx, wy](uint8_t c11, uint8_t c12, uint8_t c21, uint8_t c22) -> uint8_t
@@ -132,10 +318,15 @@ public:
             return static_cast<uint8_t>(top * (1.0f - wy) + bottom * wy);
         };
         
+        auto interpolatePlane = [&](const uint8_t* plane) -> uint8_t
+        {
+            return interpolateComponent(plane[offset11], plane[offset12], plane[offset21], plane[offset22]);
+        };
+        
         return RGB{
-            interpolateComponent(pixel11.getRed(), pixel12.getRed(), pixel21.getRed(), pixel22.getRed()),
-            interpolateComponent(pixel11.getGreen(), pixel12.getGreen(), pixel21.getGreen(), pixel22.getGreen()),
-            interpolateComponent(pixel11.getBlue(), pixel12.getBlue(), pixel21.getBlue(), pixel22.getBlue())
+            interpolatePlane(planes.red),
+            interpolatePlane(planes.green),
+            interpolatePlane(planes.blue)
         };
     }
     
@@ -148,74 +339,123 @@ public:
             return RGB{0, 0, 0};
         }
         
-        juce::Colour pixel = image.getPixelAt(x, y);
-        return RGB{
-            static_cast<uint8_t>(pixel.getRed()),
-            static_cast<uint8_t>(pixel.getGreen()),
-            static_cast<uint8_t>(pixel.getBlue())
-        };
+        const size_t offset = planes.offsetOf(x, y);
+        return RGB{planes.red[offset], planes.green[offset], planes.blue[offset]};
     }
     
     //==============================================================================
-    RGB getAreaAverage(float x, float y, int areaSize) const override
+    RGB getAreaAverage(float x, float y, int areaSize, BlurShape shape = BlurShape::Box) const override
     {
         if (!imageLoaded || areaSize < 1)
         {
             return RGB{0, 0, 0};
         }
         
-        // Limit area size to prevent excessive CPU usage
-        // At 44.1kHz, area size of 10 = 100 pixels * 44100 = 4.4M pixel reads/sec
-        areaSize = std::min(areaSize, 15); // Max radius to prevent audio glitches
-        
         // Ensure area size is odd for centered sampling (per data model requirement)
         if (areaSize % 2 == 0)
         {
             areaSize++;
         }
         
-        // Convert to integer coordinates for fast access
-        int centerX = static_cast<int>(std::round(x));
-        int centerY = static_cast<int>(std::round(y));
-        int halfSize = areaSize / 2;
+        return averageWindow(x, y, areaSize, shape);
+    }
+    
+    //==============================================================================
+    void getAreaAverages(const float* x, const float* y, const float* areaSizes, int numPositions,
+                         uint8_t* red, uint8_t* green, uint8_t* blue,
+                         BlurShape shape = BlurShape::Box) const override
+    {
+        if (!imageLoaded)
+        {
+            std::fill(red, red + numPositions, uint8_t {0});
+            std::fill(green, green + numPositions, uint8_t {0});
+            std::fill(blue, blue + numPositions, uint8_t {0});
+            return;
+        }
         
-        // Early bounds checking
-        int minX = std::max(0, centerX - halfSize);
-        int maxX = std::min(dimensions.width - 1, centerX + halfSize);
-        int minY = std::max(0, centerY - halfSize);
-        int maxY = std::min(dimensions.height - 1, centerY + halfSize);
+        for (int i = 0; i < numPositions; ++i)
+        {
+            const int areaSize = std::max(1, static_cast<int>(areaSizes[i] + 0.5f)) | 1;
+            
+            RGB pixel = averageWindow(x[i], y[i], areaSize, shape);
+            red[i] = pixel.red;
+            green[i] = pixel.green;
+            blue[i] = pixel.blue;
+        }
+    }
+    
+    //==============================================================================
+    void setSampleCacheOptions(const SampleCacheOptions& options) override
+    {
+        sampleCacheOptions = options;
+    }
+    
+    //==============================================================================
+    bool getAreaSamples(const float* x, const float* y, const float* areaSizes, int numPositions,
+                        float* output, ConversionFormula formula, BlurShape shape = BlurShape::Box) const override
+    {
+        // Only the box window is a pure summed-area lookup
+        if (!imageLoaded || shape != BlurShape::Box)
+        {
+            return false;
+        }
         
-        if (minX > maxX || minY > maxY)
+        if (sampleCache.getAreaSamples(x, y, areaSizes, numPositions, output, formula))
         {
-            return RGB{0, 0, 0};
+            return true;
         }
         
-        int totalPixels = 0;
-        long totalR = 0, totalG = 0, totalB = 0;
+        // A missing cacheable formula has been queued; have the helper build it
+        if (sampleCache.hasRequests())
+        {
+            raiseHelperRequest(sampleCacheRequest);
+        }
         
-        // Fast integer-based sampling with direct image access
-        for (int dy = minY; dy <= maxY; dy++)
+        return false;
+    }
+    
+    //==============================================================================
+    bool isPyramidReady() const override
+    {
+        return pyramidReady.load(std::memory_order_acquire);
+    }
+    
+    //==============================================================================
+    const WavetableBank* getWavetables(WavetableAxis axis) const override
+    {
+        if (!wavetablesReady.load(std::memory_order_acquire))
         {
-            for (int dx = minX; dx <= maxX; dx++)
-            {
-                RGB pixel = getPixelFast(dx, dy);
-                totalR += pixel.red;
-                totalG += pixel.green;
-                totalB += pixel.blue;
-                totalPixels++;
-            }
+            if (imageLoaded)
+                raiseHelperRequest(wavetableRequest);
+            
+            return nullptr;
         }
         
-        if (totalPixels == 0)
+        return &wavetables[axis == WavetableAxis::Rows ? 0 : 1];
+    }
+    
+    //==============================================================================
+    SpectrogramRenderer* getSpectrogram() const override
+    {
+        if (!imageLoaded)
         {
-            return RGB{0, 0, 0};
+            return nullptr;
         }
         
-        return RGB{
-            static_cast<uint8_t>(totalR / totalPixels),
-            static_cast<uint8_t>(totalG / totalPixels),
-            static_cast<uint8_t>(totalB / totalPixels)
-        };
+        raiseHelperRequest(spectrogramRequest);
+        return spectrogram.get();
+    }
+    
+    //==============================================================================
+    ImpulseResponseBuilder* getImpulseResponseBuilder() const override
+    {
+        return imageLoaded ? impulseResponses.get() : nullptr;
+    }
+    
+    //==============================================================================
+    PixelPlanes getPixelPlanes() const override
+    {
+        return imageLoaded ? planes : PixelPlanes();
     }
     
     //==============================================================================
@@ -233,7 +473,20 @@ public:
     //==============================================================================
     void clearImage() override
     {
+        stopHelper();
+        impulseResponses->stopWorker();
+        impulseResponses->setScanPaths(nullptr);
+        spectrogram->stopWorker();
+        sampleCache.clear();
         image = juce::Image();
+        redPlane.clear();
+        greenPlane.clear();
+        bluePlane.clear();
+        alphaPlane.clear();
+        planes = PixelPlanes();
+        areaTable.clear();
+        areaTable.shrink_to_fit();
+        areaTableTilesPerRow = 0;
         currentFilePath.clear();
         dimensions = {0, 0};
         imageLoaded = false;
@@ -245,6 +498,12 @@ public:
         return currentFilePath;
     }
     
+    //==============================================================================
+    juce::Image getImage() const override
+    {
+        return image;
+    }
+    
     //==============================================================================
     bool isValidPosition(float x, float y) const override
     {
@@ -256,6 +515,416 @@ public:
         return x >= 0.0f && x < static_cast<float>(dimensions.width) &&
                y >= 0.0f && y < static_cast<float>(dimensions.height);
     }
+    
+private:
+    //==============================================================================
+    // Decode-format independent conversion into aligned planes; returns false if cancelled
+    bool buildPixelPlanes(const LoadObserver& observer)
+    {
+        const int width = image.getWidth();
+        const int height = image.getHeight();
+        constexpr int alignment = PixelPlanes::planeAlignment;
+        
+        const int stride = (width + alignment - 1) / alignment * alignment;
+        const size_t planeSize = static_cast<size_t>(stride) * static_cast<size_t>(height);
+        const bool hasAlpha = image.getFormat() == juce::Image::ARGB;
+        
+        redPlane.allocate(planeSize, alignment);
+        greenPlane.allocate(planeSize, alignment);
+        bluePlane.allocate(planeSize, alignment);
+        
+        if (hasAlpha)
+        {
+            alphaPlane.allocate(planeSize, alignment);
+        }
+        
+        const juce::Image::BitmapData bitmap(image, juce::Image::BitmapData::readOnly);
+        
+        for (int y = 0; y < height; ++y)
+        {
+            if ((y & 63) == 0 && observer.isCancelled())
+            {
+                return false;
+            }
+            
+            const juce::uint8* line = bitmap.getLinePointer(y);
+            const size_t rowOffset = static_cast<size_t>(y) * static_cast<size_t>(stride);
+            uint8_t* red = redPlane.get() + rowOffset;
+            uint8_t* green = greenPlane.get() + rowOffset;
+            uint8_t* blue = bluePlane.get() + rowOffset;
+            
+            switch (bitmap.pixelFormat)
+            {
+                case juce::Image::ARGB:
+                {
+                    // Stored premultiplied; unpremultiply to match getPixelAt
+                    uint8_t* alpha = alphaPlane.get() + rowOffset;
+                    
+                    for (int x = 0; x < width; ++x)
+                    {
+                        auto pixel = *reinterpret_cast<const juce::PixelARGB*>(line + x * bitmap.pixelStride);
+                        pixel.unpremultiply();
+                        red[x] = pixel.getRed();
+                        green[x] = pixel.getGreen();
+                        blue[x] = pixel.getBlue();
+                        alpha[x] = pixel.getAlpha();
+                    }
+                    break;
+                }
+                
+                case juce::Image::RGB:
+                {
+                    // PixelRGB hides the per-platform byte order
+                    for (int x = 0; x < width; ++x)
+                    {
+                        const auto* pixel = reinterpret_cast<const juce::PixelRGB*>(line + x * bitmap.pixelStride);
+                        red[x] = pixel->getRed();
+                        green[x] = pixel->getGreen();
+                        blue[x] = pixel->getBlue();
+                    }
+                    break;
+                }
+                
+                case juce::Image::SingleChannel:
+                {
+                    // Greyscale images feed the same value to every channel
+                    for (int x = 0; x < width; ++x)
+                    {
+                        const uint8_t value = line[x * bitmap.pixelStride];
+                        red[x] = value;
+                        green[x] = value;
+                        blue[x] = value;
+                    }
+                    break;
+                }
+                
+                case juce::Image::UnknownFormat:
+                default:
+                {
+                    for (int x = 0; x < width; ++x)
+                    {
+                        const auto colour = bitmap.getPixelColour(x, y);
+                        red[x] = colour.getRed();
+                        green[x] = colour.getGreen();
+                        blue[x] = colour.getBlue();
+                    }
+                    break;
+                }
+            }
+        }
+        
+        planes.red = redPlane.get();
+        planes.green = greenPlane.get();
+        planes.blue = bluePlane.get();
+        planes.alpha = hasAlpha ? alphaPlane.get() : nullptr;
+        planes.width = width;
+        planes.height = height;
+        planes.stride = stride;
+        
+        return true;
+    }
+    
+    //==============================================================================
+    // Build the per-channel integral image from the planes; returns false if cancelled
+    bool buildAreaTable(const LoadObserver& observer)
+    {
+        const int width = planes.width;
+        const int height = planes.height;
+        
+        const int tileSize = 1 << areaTableTileShift;
+        const int tilesPerColumn = (height + tileSize) / tileSize;
+        areaTableTilesPerRow = (width + tileSize) / tileSize;
+        areaTable.assign(static_cast<size_t>(areaTableTilesPerRow) * static_cast<size_t>(tilesPerColumn)
+                             * static_cast<size_t>(tileSize * tileSize * areaTableChannels), 0u);
+        
+        uint32_t* table = areaTable.data();
+        std::atomic<bool> cancelled {false};
+        
+        // Pass 1: independent horizontal prefix sums, parallel across rows
+        parallelForRanges(height, [&](int firstRow, int endRow)
+        {
+            for (int y = firstRow; y < endRow; ++y)
+            {
+                if ((y & 63) == 0 && (cancelled.load() || observer.isCancelled()))
+                {
+                    cancelled = true;
+                    return;
+                }
+                
+                const size_t planeOffset = planes.offsetOf(0, y);
+                const uint8_t* red = planes.red + planeOffset;
+                const uint8_t* green = planes.green + planeOffset;
+                const uint8_t* blue = planes.blue + planeOffset;
+                
+                uint32_t sumR = 0, sumG = 0, sumB = 0;
+                
+                for (int x = 0; x < width; ++x)
+                {
+                    sumR += red[x];
+                    sumG += green[x];
+                    sumB += blue[x];
+                    
+                    uint32_t* entry = table + areaTableOffset(x + 1, y + 1);
+                    entry[0] = sumR;
+                    entry[1] = sumG;
+                    entry[2] = sumB;
+                }
+            }
+        });
+        
+        if (cancelled.load())
+        {
+            return false;
+        }
+        
+        // Pass 2: vertical accumulation, parallel across tile columns so no two
+        // workers write to the same tile
+        parallelForRanges(areaTableTilesPerRow, [&](int firstTile, int endTile)
+        {
+            const int firstColumn = firstTile << areaTableTileShift;
+            const int endColumn = std::min(width + 1, endTile << areaTableTileShift);
+            
+            for (int y = 1; y <= height; ++y)
+            {
+                for (int x = firstColumn; x < endColumn; ++x)
+                {
+                    const uint32_t* above = table + areaTableOffset(x, y - 1);
+                    uint32_t* entry = table + areaTableOffset(x, y);
+                    
+                    entry[0] += above[0];
+                    entry[1] += above[1];
+                    entry[2] += above[2];
+                }
+            }
+        });
+        
+        return !observer.isCancelled();
+    }
+    
+    //==============================================================================
+    // Index of the first channel of table entry (x, y) in the tiled layout
+    size_t areaTableOffset(int x, int y) const
+    {
+        const size_t tile = static_cast<size_t>(y >> areaTableTileShift) * static_cast<size_t>(areaTableTilesPerRow)
+                          + static_cast<size_t>(x >> areaTableTileShift);
+        const size_t withinTile = static_cast<size_t>(((y & areaTableTileMask) << areaTableTileShift) | (x & areaTableTileMask));
+        
+        return ((tile << (2 * areaTableTileShift)) | withinTile) * areaTableChannels;
+    }
+    
+    //==============================================================================
+    // Constant-time box average of the window centred on (centerX, centerY), clipped to the image
+    RGB averageFromAreaTable(int centerX, int centerY, int halfSize) const
+    {
+        const int minX = std::max(0, centerX - halfSize);
+        const int maxX = std::min(dimensions.width - 1, centerX + halfSize);
+        const int minY = std::max(0, centerY - halfSize);
+        const int maxY = std::min(dimensions.height - 1, centerY + halfSize);
+        
+        if (minX > maxX || minY > maxY)
+        {
+            return RGB{0, 0, 0};
+        }
+        
+        const uint32_t* topLeft = areaTable.data() + areaTableOffset(minX, minY);
+        const uint32_t* topRight = areaTable.data() + areaTableOffset(maxX + 1, minY);
+        const uint32_t* bottomLeft = areaTable.data() + areaTableOffset(minX, maxY + 1);
+        const uint32_t* bottomRight = areaTable.data() + areaTableOffset(maxX + 1, maxY + 1);
+        
+        const uint32_t totalPixels = static_cast<uint32_t>((maxX - minX + 1) * (maxY - minY + 1));
+        
+        auto average = [&](int channel) -> uint8_t
+        {
+            const uint32_t sum = bottomRight[channel] - bottomLeft[channel] - topRight[channel] + topLeft[channel];
+            return static_cast<uint8_t>(sum / totalPixels);
+        };
+        
+        return RGB{average(0), average(1), average(2)};
+    }
+    
+    //==============================================================================
+    // Disc average: horizontal bands whose half-widths follow the circle, each a four-tap lookup
+    RGB circularAverageFromAreaTable(int centerX, int centerY, int radius) const
+    {
+        const int diameter = 2 * radius + 1;
+        const int numBands = std::min(diameter, maxCircularBands);
+        const float edge = static_cast<float>(radius) + 0.5f;
+        
+        uint32_t sums[areaTableChannels] = {0, 0, 0};
+        uint32_t totalPixels = 0;
+        
+        for (int band = 0; band < numBands; ++band)
+        {
+            const int firstRow = -radius + (band * diameter) / numBands;
+            const int lastRow = -radius + ((band + 1) * diameter) / numBands - 1;
+            const float middle = 0.5f * static_cast<float>(firstRow + lastRow);
+            const int halfWidth = static_cast<int>(std::sqrt(std::max(0.0f, edge * edge - middle * middle)));
+            
+            const int minX = std::max(0, centerX - halfWidth);
+            const int maxX = std::min(dimensions.width - 1, centerX + halfWidth);
+            const int minY = std::max(0, centerY + firstRow);
+            const int maxY = std::min(dimensions.height - 1, centerY + lastRow);
+            
+            if (minX > maxX || minY > maxY)
+            {
+                continue;
+            }
+            
+            const size_t topLeft = areaTableOffset(minX, minY);
+            const size_t topRight = areaTableOffset(maxX + 1, minY);
+            const size_t bottomLeft = areaTableOffset(minX, maxY + 1);
+            const size_t bottomRight = areaTableOffset(maxX + 1, maxY + 1);
+            
+            for (int channel = 0; channel < areaTableChannels; ++channel)
+            {
+                sums[channel] += areaTable[bottomRight + channel] - areaTable[bottomLeft + channel]
+                               - areaTable[topRight + channel] + areaTable[topLeft + channel];
+            }
+            
+            totalPixels += static_cast<uint32_t>((maxX - minX + 1) * (maxY - minY + 1));
+        }
+        
+        if (totalPixels == 0)
+        {
+            return RGB{0, 0, 0};
+        }
+        
+        return RGB{
+            static_cast<uint8_t>(sums[0] / totalPixels),
+            static_cast<uint8_t>(sums[1] / totalPixels),
+            static_cast<uint8_t>(sums[2] / totalPixels)
+        };
+    }
+    
+    //==============================================================================
+    // Average an odd-sized window with the requested shape
+    RGB averageWindow(float x, float y, int areaSize, BlurShape shape) const
+    {
+        const int centerX = static_cast<int>(std::round(x));
+        const int centerY = static_cast<int>(std::round(y));
+        
+        switch (shape)
+        {
+            case BlurShape::Gaussian:
+                if (pyramidReady.load(std::memory_order_acquire))
+                {
+                    return pyramid.sample(x, y, pyramid.getLevelOfDetailForWindow(static_cast<float>(areaSize)));
+                }
+                
+                raiseHelperRequest(pyramidRequest);
+                break;
+                
+            case BlurShape::Circular:
+                return circularAverageFromAreaTable(centerX, centerY, areaSize / 2);
+                
+            case BlurShape::Box:
+            default:
+                break;
+        }
+        
+        return averageFromAreaTable(centerX, centerY, areaSize / 2);
+    }
+    
+    //==============================================================================
+    void raiseHelperRequest(uint32_t request) const
+    {
+        if ((helperRequests.fetch_or(request) & request) == 0)
+        {
+            helperWake.signal();
+        }
+    }
+    
+    void startHelper()
+    {
+        helperCancelled = false;
+        helper = std::thread([this] { runHelper(); });
+    }
+    
+    void stopHelper()
+    {
+        if (helper.joinable())
+        {
+            helperCancelled = true;
+            helperWake.signal();
+            helper.join();
+        }
+        
+        helperWake.reset();
+        helperRequests = 0;
+        pyramidReady = false;
+        wavetablesReady = false;
+    }
+    
+    void runHelper()
+    {
+        const auto isCancelled = [this] { return helperCancelled.load(); };
+        uint32_t started = 0;
+        
+        // Requests raised while a build runs leave the event signalled, so none are missed
+        while (helperWake.wait(-1) && !isCancelled())
+        {
+            const uint32_t requested = helperRequests.fetch_and(~sampleCacheRequest);
+            const uint32_t newlyRequested = requested & ~started;
+            started |= requested & ~sampleCacheRequest;
+            
+            // Workers first, since starting them is quick and they feed the audio thread
+            if ((newlyRequested & spectrogramRequest) != 0)
+            {
+                spectrogram->startWorker();
+            }
+            
+            if ((newlyRequested & impulseResponseRequest) != 0)
+            {
+                impulseResponses->startWorker();
+            }
+            
+            if ((requested & sampleCacheRequest) != 0)
+            {
+                buildRequestedSamples(isCancelled);
+            }
+            
+            if ((newlyRequested & pyramidRequest) != 0)
+            {
+                const bool built = pyramid.build(planes, ImagePyramid::Filter::Gaussian, isCancelled);
+                pyramidReady.store(built, std::memory_order_release);
+            }
+            
+            if ((newlyRequested & wavetableRequest) != 0)
+            {
+                const bool built = wavetables[0].build(planes, WavetableAxis::Rows, isCancelled)
+                                && wavetables[1].build(planes, WavetableAxis::Columns, isCancelled);
+                wavetablesReady.store(built, std::memory_order_release);
+            }
+        }
+    }
+    
+    //==============================================================================
+    // Size the sample cache and build the preload formula; returns false if cancelled
+    bool prepareSampleCache(const LoadObserver& observer)
+    {
+        sampleCache.prepare(planes, sampleCacheOptions.budgetBytes);
+        
+        if (!sampleCacheOptions.preload || !SamplePlaneCache::isCacheable(sampleCacheOptions.preloadFormula))
+        {
+            return true;
+        }
+        
+        sampleCache.build(sampleCacheOptions.preloadFormula, [&observer] { return observer.isCancelled(); });
+        return !observer.isCancelled();
+    }
+    
+    void buildRequestedSamples(const std::function<bool()>& isCancelled)
+    {
+        const uint32_t requested = sampleCache.takeRequests();
+        
+        for (int formula = 0; formula < 32 && !isCancelled(); ++formula)
+        {
+            if ((requested & (1u << formula)) != 0)
+            {
+                sampleCache.build(static_cast<ConversionFormula>(formula), isCancelled);
+            }
+        }
+    }
 };
 
 //==============================================================================
@@ -1,8 +1,9 @@
 #pragma once
 
 #include <juce_graphics/juce_graphics.h>
-#include "ImageScanner.h"
+#include "ScanTypes.h"
 #include "AudioSynthesis.h"
+#include <functional>
 #include <string>
 #include <memory>
 
@@ -19,6 +20,101 @@ struct LoadResult
         : success(s), errorMessage(msg) {}
 };
 
+//==============================================================================
+/**
+ * Read-only view of the planar pixel store built at load time
+ * 
+ * Each channel is a contiguous uint8 plane whose rows start on aligned
+ * addresses, independent of the pixel format JUCE decoded the file into.
+ * Pixel (x, y) of a plane is at offset y * stride + x.
+ */
+struct PixelPlanes
+{
+    static constexpr int planeAlignment = 64;  // Row and plane alignment in bytes
+    
+    const uint8_t* red {nullptr};
+    const uint8_t* green {nullptr};
+    const uint8_t* blue {nullptr};
+    const uint8_t* alpha {nullptr};  // nullptr when the image has no alpha channel
+    int width {0};
+    int height {0};
+    int stride {0};
+    
+    bool isValid() const
+    {
+        return red != nullptr && green != nullptr && blue != nullptr && width > 0 && height > 0;
+    }
+    
+    size_t offsetOf(int x, int y) const
+    {
+        return static_cast<size_t>(y) * static_cast<size_t>(stride) + static_cast<size_t>(x);
+    }
+};
+
+//==============================================================================
+/**
+ * Shape of the window used when averaging an area around a scan position
+ */
+enum class BlurShape
+{
+    Box,        // Exact square average from the summed-area table
+    Gaussian,   // Soft round kernel from the Gaussian pyramid (box until it is built)
+    Circular    // Disc average approximated by summed-area table bands
+};
+
+//==============================================================================
+/**
+ * Image axis whose lines become single-cycle wavetables
+ */
+enum class WavetableAxis
+{
+    Rows,       // Each row is one cycle; tables are selected by y
+    Columns     // Each column is one cycle; tables are selected by x
+};
+
+class WavetableBank;
+class SpectrogramRenderer;
+class ImpulseResponseBuilder;
+
+//==============================================================================
+/**
+ * Settings of the per-formula sample cache built alongside each image
+ * 
+ * Linear conversion formulas can be cached as tables of converted samples, so
+ * that area-averaged audio needs no per-sample conversion. Tables for other
+ * formulas are built lazily in the background the first time they are read.
+ */
+struct SampleCacheOptions
+{
+    size_t budgetBytes {0};                                         // Memory for sample tables, 0 disables the cache
+    bool preload {false};                                           // Build preloadFormula's table during the load
+    ConversionFormula preloadFormula {ConversionFormula::RGBAverage};
+};
+
+//==============================================================================
+/**
+ * Optional hooks for long-running image loads
+ * 
+ * Used by background loading to report progress and to abandon a load that
+ * has been superseded by a newer request.
+ */
+struct LoadObserver
+{
+    std::function<void(float)> onProgress;  // Progress in range [0.0, 1.0]
+    std::function<bool()> shouldCancel;     // Returns true to abandon the load
+    
+    void reportProgress(float progress) const
+    {
+        if (onProgress)
+            onProgress(progress);
+    }
+    
+    bool isCancelled() const
+    {
+        return shouldCancel && shouldCancel();
+    }
+};
+
 //==============================================================================
 /**
  * Image loader interface for loading and managing image files
@@ -31,9 +127,10 @@ public:
     /**
      * Load image from file path
      * @param filePath Absolute path to image file
+     * @param observer Optional progress reporting and cancellation hooks
      * @return LoadResult with success/failure and error details
      */
-    virtual LoadResult loadImage(const std::string& filePath) = 0;
+    virtual LoadResult loadImage(const std::string& filePath, const LoadObserver& observer = {}) = 0;
     
     /**
      * Get pixel RGB values for specified coordinates with sub-pixel precision
@@ -45,12 +142,94 @@ public:
     
     /**
      * Get averaged RGB values for area around coordinates
+     * Constant time for any area size; windows are clipped to the image.
      * @param x Center X coordinate
      * @param y Center Y coordinate
      * @param areaSize Size of area to average (pixel radius)
+     * @param shape Averaging window shape
      * @return RGB struct with averaged values
      */
-    virtual RGB getAreaAverage(float x, float y, int areaSize) const = 0;
+    virtual RGB getAreaAverage(float x, float y, int areaSize, BlurShape shape = BlurShape::Box) const = 0;
+    
+    /**
+     * Get averaged RGB values for a block of positions in a single call
+     * @param x Array of center X coordinates
+     * @param y Array of center Y coordinates
+     * @param areaSizes Array of area sizes (pixel radius), rounded to the nearest pixel
+     * @param numPositions Number of positions to gather
+     * @param red Output array receiving averaged red values
+     * @param green Output array receiving averaged green values
+     * @param blue Output array receiving averaged blue values
+     * @param shape Averaging window shape
+     */
+    virtual void getAreaAverages(const float* x, const float* y, const float* areaSizes, int numPositions,
+                                 uint8_t* red, uint8_t* green, uint8_t* blue,
+                                 BlurShape shape = BlurShape::Box) const = 0;
+    
+    /**
+     * Set the sample cache settings used by subsequent loads
+     * @param options Memory budget and formula to preload
+     */
+    virtual void setSampleCacheOptions(const SampleCacheOptions& options) = 0;
+    
+    /**
+     * Get area-averaged audio samples straight from the sample cache (real-time safe)
+     * Only box averages of cached formulas are served; anything else returns
+     * false, and a cacheable formula that is missing is queued for a background
+     * build. Samples are at unity gain in [-1.0, 1.0].
+     * @param x Array of center X coordinates
+     * @param y Array of center Y coordinates
+     * @param areaSizes Array of area sizes (pixel radius), rounded to the nearest pixel
+     * @param numPositions Number of positions to read
+     * @param output Array receiving the samples
+     * @param formula Conversion formula
+     * @param shape Averaging window shape
+     * @return true if the samples were written
+     */
+    virtual bool getAreaSamples(const float* x, const float* y, const float* areaSizes, int numPositions,
+                                float* output, ConversionFormula formula,
+                                BlurShape shape = BlurShape::Box) const = 0;
+    
+    /**
+     * Check whether the background pyramid build has finished
+     * The build starts with the first Gaussian average; until it finishes,
+     * Gaussian averages fall back to the box average.
+     * @return true if pyramid levels are available
+     */
+    virtual bool isPyramidReady() const = 0;
+    
+    /**
+     * Get the band-limited wavetables of one axis (real-time safe)
+     * Built on a helper thread once first asked for; the bank stays valid until
+     * the image is cleared or another image is loaded.
+     * @param axis Whether rows or columns are the tables
+     * @return Finished wavetable bank, or nullptr while it is still being built
+     */
+    virtual const WavetableBank* getWavetables(WavetableAxis axis) const = 0;
+    
+    /**
+     * Get the spectrogram resynthesis of the image (real-time safe)
+     * The renderer's worker starts after the first call and stops when the image
+     * is cleared; the audio thread may call setSettings() and read() on it.
+     * @return Renderer for the loaded image, or nullptr if no image is loaded
+     */
+    virtual SpectrogramRenderer* getSpectrogram() const = 0;
+    
+    /**
+     * Get the builder of impulse responses read from the image (real-time safe)
+     * The builder's worker starts after its first request() and stops when the
+     * image is cleared; the audio thread may call request() and takeImpulseResponse() on it.
+     * Responses are read along the scan paths handed to it with setScanPaths().
+     * @return Builder for the loaded image, or nullptr if no image is loaded
+     */
+    virtual ImpulseResponseBuilder* getImpulseResponseBuilder() const = 0;
+    
+    /**
+     * Get raw read-only access to the planar pixel store for block kernels
+     * The view stays valid until the image is cleared or another image is loaded.
+     * @return Planar pixel view, invalid if no image is loaded
+     */
+    virtual PixelPlanes getPixelPlanes() const = 0;
     
     /**
      * Get image dimensions
@@ -75,6 +254,12 @@ public:
      */
     virtual std::string getFilePath() const = 0;
     
+    /**
+     * Get the decoded image for display purposes
+     * @return Decoded image or an invalid image if none is loaded
+     */
+    virtual juce::Image getImage() const = 0;
+    
     /**
      * Check if coordinates are within image bounds
      * @param x X coordinate to check
@@ -0,0 +1,123 @@
+/*
+ * ImagePublisher.cpp - Lock-free image hand-over implementation
+ */
+
+#include "ImagePublisher.h"
+
+//==============================================================================
+ImagePublisher::ImagePublisher()
+    : reclamationThread(*this)
+{
+    reclamationThread.startThread();
+}
+
+ImagePublisher::~ImagePublisher()
+{
+    reclamationThread.signalThreadShouldExit();
+    reclaimEvent.signal();
+    reclamationThread.stopThread(1000);
+
+    // No reader can be active once the owning processor is being destroyed
+    delete current.exchange(nullptr);
+
+    const juce::ScopedLock lock(retiredLock);
+    retired.clear();
+}
+
+//==============================================================================
+void ImagePublisher::publish(std::unique_ptr<ImageSnapshot> snapshot)
+{
+    if (snapshot != nullptr)
+    {
+        snapshot->generation = publishedGenerations.fetch_add(1) + 1;
+    }
+    
+    retire(current.exchange(snapshot.release()));
+}
+
+void ImagePublisher::clear()
+{
+    retire(current.exchange(nullptr));
+}
+
+const ImageSnapshot* ImagePublisher::getCurrentForWriter() const
+{
+    return current.load();
+}
+
+//==============================================================================
+void ImagePublisher::retire(ImageSnapshot* snapshot)
+{
+    // Any read that starts after this increment sees the new pointer
+    const auto retireEpoch = globalEpoch.fetch_add(1) + 1;
+
+    if (snapshot == nullptr)
+    {
+        return;
+    }
+
+    {
+        const juce::ScopedLock lock(retiredLock);
+        retired.push_back({std::unique_ptr<ImageSnapshot>(snapshot), retireEpoch});
+    }
+
+    reclaimEvent.signal();
+}
+
+void ImagePublisher::reclaim()
+{
+    std::vector<RetiredSnapshot> reclaimable;
+
+    {
+        const juce::ScopedLock lock(retiredLock);
+
+        const auto epoch = readerEpoch.load();
+
+        for (auto it = retired.begin(); it != retired.end();)
+        {
+            // Safe once the reader is idle or started reading after the swap
+            if (epoch == readerIdle || epoch >= it->retireEpoch)
+            {
+                reclaimable.push_back(std::move(*it));
+                it = retired.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    // Snapshots are destroyed here, outside the lock, on the reclamation thread
+    reclaimable.clear();
+}
+
+//==============================================================================
+ImagePublisher::ReadScope::ReadScope(ImagePublisher& publisher)
+    : owner(publisher)
+{
+    owner.readerEpoch.store(owner.globalEpoch.load());
+    snapshot = owner.current.load();
+}
+
+ImagePublisher::ReadScope::~ReadScope()
+{
+    owner.readerEpoch.store(readerIdle);
+}
+
+//==============================================================================
+ImagePublisher::ReclamationThread::ReclamationThread(ImagePublisher& publisher)
+    : juce::Thread("Needles Image Reclamation")
+    , owner(publisher)
+{
+}
+
+void ImagePublisher::ReclamationThread::run()
+{
+    while (!threadShouldExit())
+    {
+        // Retry periodically while a retired snapshot is still being read
+        owner.reclaimEvent.wait(50);
+        owner.reclaim();
+    }
+}
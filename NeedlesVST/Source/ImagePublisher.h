@@ -0,0 +1,126 @@
+/*
+ * ImagePublisher.h - Lock-free hand-over of decoded images to the audio thread
+ *
+ * Images are decoded and prepared away from the audio thread, then published
+ * with a single atomic pointer swap. The audio thread keeps reading the previous
+ * snapshot until the swap and never blocks, allocates or frees. Replaced
+ * snapshots are retired and deleted later on a background reclamation thread
+ * once the audio thread can no longer be reading them.
+ */
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "ImageLoader.h"
+#include "ScanPath.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+//==============================================================================
+/**
+ * Immutable image state shared with the audio thread
+ *
+ * Everything the audio thread needs about an image is bundled here and built
+ * before publication. Once published a snapshot is never modified.
+ */
+struct ImageSnapshot
+{
+    ScanPathSet scanPaths;    // Every scan pattern compiled for these dimensions; outlives the loader's workers
+    std::unique_ptr<IImageLoader> loader;
+    Dimensions dimensions;
+    std::string filePath;
+    uint64_t generation {0};  // Assigned on publication
+};
+
+//==============================================================================
+/**
+ * Read-copy-update publisher for ImageSnapshot
+ *
+ * Supports a single reader (the audio thread) and any number of writer threads.
+ * The reader marks the epoch in which it started reading; a retired snapshot is
+ * only deleted once the reader is idle or has started a newer read.
+ */
+class ImagePublisher
+{
+public:
+    ImagePublisher();
+    ~ImagePublisher();
+
+    /**
+     * Publish a new snapshot, retiring the current one (never call from the audio thread)
+     * @param snapshot Fully prepared snapshot; ownership is transferred
+     */
+    void publish(std::unique_ptr<ImageSnapshot> snapshot);
+
+    /**
+     * Retire the current snapshot so the audio thread sees no image
+     */
+    void clear();
+
+    /**
+     * Get the current snapshot from a non-audio thread for inspection
+     * Only valid while the caller is the sole writer (e.g. the message thread).
+     * @return Current snapshot or nullptr
+     */
+    const ImageSnapshot* getCurrentForWriter() const;
+
+    //==============================================================================
+    /**
+     * RAII read section for the audio thread
+     *
+     * The snapshot returned by get() stays valid until the scope is destroyed.
+     */
+    class ReadScope
+    {
+    public:
+        explicit ReadScope(ImagePublisher& publisher);
+        ~ReadScope();
+
+        const ImageSnapshot* get() const { return snapshot; }
+
+    private:
+        ImagePublisher& owner;
+        const ImageSnapshot* snapshot;
+
+        JUCE_DECLARE_NON_COPYABLE(ReadScope)
+    };
+
+private:
+    //==============================================================================
+    struct RetiredSnapshot
+    {
+        std::unique_ptr<ImageSnapshot> snapshot;
+        uint64_t retireEpoch;
+    };
+
+    class ReclamationThread : public juce::Thread
+    {
+    public:
+        explicit ReclamationThread(ImagePublisher& publisher);
+        void run() override;
+
+    private:
+        ImagePublisher& owner;
+    };
+
+    void retire(ImageSnapshot* snapshot);
+    void reclaim();
+
+    // Epoch value used by the reader when it is not inside a ReadScope
+    static constexpr uint64_t readerIdle = 0;
+
+    std::atomic<ImageSnapshot*> current {nullptr};
+    std::atomic<uint64_t> publishedGenerations {0};
+    std::atomic<uint64_t> globalEpoch {1};
+    std::atomic<uint64_t> readerEpoch {readerIdle};
+
+    juce::CriticalSection retiredLock;
+    std::vector<RetiredSnapshot> retired;
+    juce::WaitableEvent reclaimEvent;
+    ReclamationThread reclamationThread;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ImagePublisher)
+};
@@ -0,0 +1,249 @@
+/*
+ * ImagePyramid.cpp - Multi-resolution image pyramid implementation
+ */
+
+#include "ImagePyramid.h"
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+bool ImagePyramid::build(const PixelPlanes& planes, Filter filterToUse, const std::function<bool()>& shouldCancel)
+{
+    levels.clear();
+    levelStorage.clear();
+    filter = filterToUse;
+    
+    if (!planes.isValid())
+    {
+        return false;
+    }
+    
+    levels.push_back(planes);
+    
+    // Halve until both dimensions reach a single pixel
+    while (levels.back().width > 1 || levels.back().height > 1)
+    {
+        levelStorage.emplace_back();
+        PixelPlanes next;
+        
+        const bool completed = filter == Filter::Box
+            ? downsampleBox(levels.back(), next, levelStorage.back(), shouldCancel)
+            : downsampleGaussian(levels.back(), next, levelStorage.back(), shouldCancel);
+        
+        if (!completed)
+        {
+            levels.clear();
+            levelStorage.clear();
+            return false;
+        }
+        
+        levels.push_back(next);
+    }
+    
+    return true;
+}
+
+//==============================================================================
+PixelPlanes ImagePyramid::allocateLevel(int width, int height, std::vector<uint8_t>& store)
+{
+    const size_t planeSize = static_cast<size_t>(width) * static_cast<size_t>(height);
+    store.assign(planeSize * 3, 0);
+    
+    PixelPlanes level;
+    level.red = store.data();
+    level.green = store.data() + planeSize;
+    level.blue = store.data() + planeSize * 2;
+    level.width = width;
+    level.height = height;
+    level.stride = width;
+    return level;
+}
+
+bool ImagePyramid::downsampleBox(const PixelPlanes& source, PixelPlanes& destination, std::vector<uint8_t>& store,
+                                 const std::function<bool()>& shouldCancel)
+{
+    const int width = (source.width + 1) / 2;
+    const int height = (source.height + 1) / 2;
+    destination = allocateLevel(width, height, store);
+    
+    const uint8_t* sourcePlanes[] = {source.red, source.green, source.blue};
+    uint8_t* destinationPlanes[] = {const_cast<uint8_t*>(destination.red),
+                                    const_cast<uint8_t*>(destination.green),
+                                    const_cast<uint8_t*>(destination.blue)};
+    
+    for (int y = 0; y < height; ++y)
+    {
+        if ((y & 63) == 0 && shouldCancel && shouldCancel())
+        {
+            return false;
+        }
+        
+        // Odd edges repeat the last row/column
+        const int y0 = 2 * y;
+        const int y1 = std::min(y0 + 1, source.height - 1);
+        
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            const uint8_t* row0 = sourcePlanes[channel] + source.offsetOf(0, y0);
+            const uint8_t* row1 = sourcePlanes[channel] + source.offsetOf(0, y1);
+            uint8_t* output = destinationPlanes[channel] + destination.offsetOf(0, y);
+            
+            for (int x = 0; x < width; ++x)
+            {
+                const int x0 = 2 * x;
+                const int x1 = std::min(x0 + 1, source.width - 1);
+                const int sum = row0[x0] + row0[x1] + row1[x0] + row1[x1];
+                output[x] = static_cast<uint8_t>((sum + 2) >> 2);
+            }
+        }
+    }
+    
+    return true;
+}
+
+bool ImagePyramid::downsampleGaussian(const PixelPlanes& source, PixelPlanes& destination, std::vector<uint8_t>& store,
+                                      const std::function<bool()>& shouldCancel)
+{
+    // Separable [1 4 6 4 1] / 16 binomial, evaluated only at the kept samples
+    static constexpr int taps[] = {1, 4, 6, 4, 1};
+    
+    const int width = (source.width + 1) / 2;
+    const int height = (source.height + 1) / 2;
+    destination = allocateLevel(width, height, store);
+    
+    const uint8_t* sourcePlanes[] = {source.red, source.green, source.blue};
+    uint8_t* destinationPlanes[] = {const_cast<uint8_t*>(destination.red),
+                                    const_cast<uint8_t*>(destination.green),
+                                    const_cast<uint8_t*>(destination.blue)};
+    
+    // Horizontal pass output: decimated columns, full-resolution rows (max 255 * 16)
+    std::vector<uint16_t> horizontal(static_cast<size_t>(width) * static_cast<size_t>(source.height));
+    
+    for (int channel = 0; channel < 3; ++channel)
+    {
+        for (int y = 0; y < source.height; ++y)
+        {
+            if ((y & 63) == 0 && shouldCancel && shouldCancel())
+            {
+                return false;
+            }
+            
+            const uint8_t* row = sourcePlanes[channel] + source.offsetOf(0, y);
+            uint16_t* output = horizontal.data() + static_cast<size_t>(y) * static_cast<size_t>(width);
+            
+            for (int x = 0; x < width; ++x)
+            {
+                int sum = 0;
+                
+                for (int tap = 0; tap < 5; ++tap)
+                {
+                    const int sourceX = juce::jlimit(0, source.width - 1, 2 * x + tap - 2);
+                    sum += taps[tap] * row[sourceX];
+                }
+                
+                output[x] = static_cast<uint16_t>(sum);
+            }
+        }
+        
+        for (int y = 0; y < height; ++y)
+        {
+            uint8_t* output = destinationPlanes[channel] + destination.offsetOf(0, y);
+            
+            const uint16_t* rows[5];
+            for (int tap = 0; tap < 5; ++tap)
+            {
+                const int sourceY = juce::jlimit(0, source.height - 1, 2 * y + tap - 2);
+                rows[tap] = horizontal.data() + static_cast<size_t>(sourceY) * static_cast<size_t>(width);
+            }
+            
+            for (int x = 0; x < width; ++x)
+            {
+                uint32_t sum = 0;
+                
+                for (int tap = 0; tap < 5; ++tap)
+                {
+                    sum += static_cast<uint32_t>(taps[tap]) * rows[tap][x];
+                }
+                
+                output[x] = static_cast<uint8_t>((sum + 128) >> 8);
+            }
+        }
+    }
+    
+    return true;
+}
+
+//==============================================================================
+void ImagePyramid::sampleLevel(const PixelPlanes& level, float x, float y, float scale, float* rgb)
+{
+    // Map full-resolution pixel centres onto this level's pixel centres
+    const float levelX = juce::jlimit(0.0f, static_cast<float>(level.width - 1), (x + 0.5f) * scale - 0.5f);
+    const float levelY = juce::jlimit(0.0f, static_cast<float>(level.height - 1), (y + 0.5f) * scale - 0.5f);
+    
+    const int x0 = static_cast<int>(levelX);
+    const int y0 = static_cast<int>(levelY);
+    const int x1 = std::min(x0 + 1, level.width - 1);
+    const int y1 = std::min(y0 + 1, level.height - 1);
+    const float fx = levelX - static_cast<float>(x0);
+    const float fy = levelY - static_cast<float>(y0);
+    
+    const size_t offset00 = level.offsetOf(x0, y0);
+    const size_t offset10 = level.offsetOf(x1, y0);
+    const size_t offset01 = level.offsetOf(x0, y1);
+    const size_t offset11 = level.offsetOf(x1, y1);
+    
+    const uint8_t* planes[] = {level.red, level.green, level.blue};
+    
+    for (int channel = 0; channel < 3; ++channel)
+    {
+        const uint8_t* plane = planes[channel];
+        const float top = plane[offset00] + fx * (plane[offset10] - plane[offset00]);
+        const float bottom = plane[offset01] + fx * (plane[offset11] - plane[offset01]);
+        rgb[channel] = top + fy * (bottom - top);
+    }
+}
+
+RGB ImagePyramid::sample(float x, float y, float levelOfDetail) const
+{
+    if (levels.empty())
+    {
+        return RGB{0, 0, 0};
+    }
+    
+    const float maxLevel = static_cast<float>(levels.size() - 1);
+    const float lod = juce::jlimit(0.0f, maxLevel, levelOfDetail);
+    const int fineLevel = static_cast<int>(lod);
+    const int coarseLevel = std::min(fineLevel + 1, static_cast<int>(levels.size()) - 1);
+    const float blend = lod - static_cast<float>(fineLevel);
+    
+    float fine[3];
+    sampleLevel(levels[static_cast<size_t>(fineLevel)], x, y, std::ldexp(1.0f, -fineLevel), fine);
+    
+    if (blend > 0.0f && coarseLevel != fineLevel)
+    {
+        float coarse[3];
+        sampleLevel(levels[static_cast<size_t>(coarseLevel)], x, y, std::ldexp(1.0f, -coarseLevel), coarse);
+        
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            fine[channel] += blend * (coarse[channel] - fine[channel]);
+        }
+    }
+    
+    return RGB{
+        static_cast<uint8_t>(juce::jlimit(0.0f, 255.0f, fine[0] + 0.5f)),
+        static_cast<uint8_t>(juce::jlimit(0.0f, 255.0f, fine[1] + 0.5f)),
+        static_cast<uint8_t>(juce::jlimit(0.0f, 255.0f, fine[2] + 0.5f))
+    };
+}
+
+float ImagePyramid::getLevelOfDetailForWindow(float windowSize) const
+{
+    // A box of side s has sigma s / sqrt(12); after L binomial levels the
+    // accumulated sigma is about 2^L / sqrt(3), so the levels match at 2^L = s / 2.
+    // Box mips are matched directly at 2^L = s.
+    const float levelScale = filter == Filter::Gaussian ? windowSize * 0.5f : windowSize;
+    const float lod = std::log2(std::max(1.0f, levelScale));
+    
+    return juce::jlimit(0.0f, static_cast<float>(std::max(0, getNumLevels() - 1)), lod);
+}
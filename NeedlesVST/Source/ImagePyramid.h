@@ -0,0 +1,76 @@
+/*
+ * ImagePyramid.h - Multi-resolution prefiltered copies of a loaded image
+ * 
+ * Each level halves the previous one after a box or Gaussian prefilter, so a
+ * blur of any radius becomes a trilinear lookup between two adjacent levels.
+ * Level 0 references the loader's own planes; the coarser levels add about a
+ * third of the original memory.
+ */
+
+#pragma once
+
+#include "ImageLoader.h"
+#include <functional>
+#include <vector>
+
+//==============================================================================
+/**
+ * Mip pyramid over planar RGB pixel data
+ * 
+ * Built once off the audio thread and read-only afterwards, so sampling is
+ * safe from any thread once build() has returned.
+ */
+class ImagePyramid
+{
+public:
+    enum class Filter
+    {
+        Box,        // 2x2 average per level
+        Gaussian    // 5-tap binomial prefilter per level
+    };
+    
+    ImagePyramid() = default;
+    
+    /**
+     * Build all levels from full-resolution planes (never call from the audio thread)
+     * @param planes Source planes; must outlive the pyramid
+     * @param filter Prefilter applied before each decimation
+     * @param shouldCancel Polled between rows; may be empty
+     * @return false if the planes were invalid or the build was cancelled
+     */
+    bool build(const PixelPlanes& planes, Filter filter, const std::function<bool()>& shouldCancel = {});
+    
+    /**
+     * Sample with trilinear interpolation between the two nearest levels
+     * @param x X coordinate in full-resolution pixels
+     * @param y Y coordinate in full-resolution pixels
+     * @param levelOfDetail 0 = full resolution, each +1 halves the resolution
+     * @return Filtered RGB value
+     */
+    RGB sample(float x, float y, float levelOfDetail) const;
+    
+    /**
+     * Level of detail whose prefilter best matches a square averaging window
+     * @param windowSize Window side length in full-resolution pixels
+     * @return Fractional level of detail, clamped to the available levels
+     */
+    float getLevelOfDetailForWindow(float windowSize) const;
+    
+    int getNumLevels() const { return static_cast<int>(levels.size()); }
+    Filter getFilter() const { return filter; }
+    const PixelPlanes& getLevel(int index) const { return levels[static_cast<size_t>(index)]; }
+    
+private:
+    //==============================================================================
+    bool downsampleBox(const PixelPlanes& source, PixelPlanes& destination, std::vector<uint8_t>& store,
+                       const std::function<bool()>& shouldCancel);
+    bool downsampleGaussian(const PixelPlanes& source, PixelPlanes& destination, std::vector<uint8_t>& store,
+                            const std::function<bool()>& shouldCancel);
+    
+    static PixelPlanes allocateLevel(int width, int height, std::vector<uint8_t>& store);
+    static void sampleLevel(const PixelPlanes& level, float x, float y, float scale, float* rgb);
+    
+    Filter filter {Filter::Gaussian};
+    std::vector<PixelPlanes> levels;                 // Level 0 views the source planes
+    std::vector<std::vector<uint8_t>> levelStorage;  // Owned storage for levels 1..n
+};
@@ -1,10 +1,16 @@
 #include "ImageScanner.h"
+#include "ScanPath.h"
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <memory>
 
 //==============================================================================
 /**
- * Concrete implementation of IImageScanner with alternating scanline pattern
+ * Concrete implementation of IImageScanner following precompiled scan paths
+ * 
+ * The scan state is a single phase (distance along the path); positions are
+ * read from the compiled ScanPath of the current pattern.
  */
 class ImageScanner : public IImageScanner
 {
@@ -16,9 +22,16 @@ private:
     bool isInitialized;
     bool scanComplete;
     
-    // Scanline-specific state
-    int currentLine;
-    bool scanningRightToLeft;  // Alternates each scanline
+    // Path state
+    ScanPathSet ownedPaths;                 // Used by initialize(width, height)
+    const ScanPathSet* paths;
+    const ScanPath* activePath;
+    double phase;
+    int segmentHint;
+    
+    // Phases of one sub-block of advancePositions
+    static constexpr int phaseChunkSize = 256;
+    std::array<double, phaseChunkSize> phaseChunk;
     
 public:
     ImageScanner() 
@@ -28,16 +41,28 @@ public:
         , loopingEnabled(true)
         , isInitialized(false)
         , scanComplete(false)
-        , currentLine(0)
-        , scanningRightToLeft(false)
+        , paths(nullptr)
+        , activePath(nullptr)
+        , phase(0.0)
+        , segmentHint(-1)
     {
     }
     
     //==============================================================================
     void initialize(int width, int height) override
     {
-        imageDimensions = Dimensions(width, height);
-        isInitialized = imageDimensions.isValid();
+        ownedPaths.compile(Dimensions(width, height));
+        initialize(ownedPaths);
+    }
+    
+    //==============================================================================
+    void initialize(const ScanPathSet& pathSet) override
+    {
+        paths = &pathSet;
+        imageDimensions = pathSet.dimensions;
+        pathSet.request(currentPattern);
+        activePath = &pathSet.get(currentPattern);
+        isInitialized = imageDimensions.isValid() && !activePath->isEmpty();
         
         if (isInitialized)
         {
@@ -59,35 +84,70 @@ public:
             return currentPosition;
         }
         
-        // Apply speed multiplier to position advancement
-        switch (currentPattern)
+        // Speed is in pixels of path travel per sample
+        phase += speed;
+        wrapPhase();
+        
+        currentPosition = activePath->getPositionAt(phase, segmentHint);
+        return currentPosition;
+    }
+    
+    //==============================================================================
+    void advancePositions(const float* speeds, float* x, float* y, int numSamples) override
+    {
+        advanceBlock([speeds](int i) { return speeds[i]; }, x, y, numSamples);
+    }
+    
+    void advancePositions(float speed, float* x, float* y, int numSamples) override
+    {
+        advanceBlock([speed](int) { return speed; }, x, y, numSamples);
+    }
+    
+    //==============================================================================
+    void setPhase(double arcLength) override
+    {
+        if (!isInitialized)
         {
-            case ScanPattern::Horizontal:
-                advanceHorizontalScan(speed);
-                break;
-                
-            case ScanPattern::Vertical:
-                advanceVerticalScan(speed);
-                break;
-                
-            case ScanPattern::Diagonal:
-                advanceDiagonalScan(speed);
-                break;
-                
-            case ScanPattern::Spiral:
-                advanceSpiralScan(speed);
-                break;
+            return;
         }
         
-        return currentPosition;
+        phase = arcLength;
+        scanComplete = false;
+        wrapPhase();
+        
+        currentPosition = activePath->getPositionAt(phase, segmentHint);
+    }
+    
+    //==============================================================================
+    double getPhase() const override
+    {
+        return phase;
+    }
+    
+    //==============================================================================
+    double getPathLength() const override
+    {
+        return isInitialized ? activePath->getLength() : 0.0;
     }
     
     //==============================================================================
     void setScanPattern(ScanPattern pattern) override
     {
-        if (currentPattern != pattern)
+        currentPattern = pattern;
+        
+        if (paths == nullptr)
         {
-            currentPattern = pattern;
+            return;
+        }
+        
+        // A deferred path scans its stand-in until it has been built, then takes over
+        paths->request(pattern);
+        const ScanPath* path = &paths->get(pattern);
+        
+        if (path != activePath)
+        {
+            activePath = path;
+            
             if (isInitialized)
             {
                 resetPosition();
@@ -125,10 +185,10 @@ public:
             return;
         }
         
-        currentPosition = Position(0.0f, 0.0f);
-        currentLine = 0;
-        scanningRightToLeft = false;
+        phase = 0.0;
+        segmentHint = -1;
         scanComplete = false;
+        currentPosition = activePath->getPositionAt(phase, segmentHint);
     }
     
     //==============================================================================
@@ -139,118 +199,80 @@ public:
     
 private:
     //==============================================================================
-    void advanceHorizontalScan(float speed)
+    template <typename SpeedSource>
+    void advanceBlock(SpeedSource speedAt, float* x, float* y, int numSamples)
     {
-        if (scanningRightToLeft)
+        if (numSamples <= 0)
         {
-            // Scanning from right to left
-            currentPosition.x -= speed;
-            
-            if (currentPosition.x <= 0.0f)
-            {
-                // Reached left edge, move to next line
-                currentPosition.x = 0.0f;
-                moveToNextScanLine();
-            }
+            return;
         }
-        else
+        
+        if (!isInitialized || scanComplete)
+        {
+            std::fill(x, x + numSamples, currentPosition.x);
+            std::fill(y, y + numSamples, currentPosition.y);
+            return;
+        }
+        
+        const double length = activePath->getLength();
+        
+        for (int chunkStart = 0; chunkStart < numSamples; chunkStart += phaseChunkSize)
         {
-            // Scanning from left to right
-            currentPosition.x += speed;
+            const int chunkSize = std::min(phaseChunkSize, numSamples - chunkStart);
             
-            if (currentPosition.x >= static_cast<float>(imageDimensions.width - 1))
+            // Phase accumulation; wraps are rare, so the common case is a plain add
+            for (int i = 0; i < chunkSize; ++i)
             {
-                // Reached right edge, move to next line
-                currentPosition.x = static_cast<float>(imageDimensions.width - 1);
-                moveToNextScanLine();
+                if (!scanComplete)
+                {
+                    phase += speedAt(chunkStart + i);
+                    
+                    if (phase >= length || phase < 0.0)
+                    {
+                        wrapPhase();
+                    }
+                }
+                
+                phaseChunk[static_cast<size_t>(i)] = phase;
             }
+            
+            // Positions along straight segments in tight interpolation loops
+            activePath->getPositions(phaseChunk.data(), x + chunkStart, y + chunkStart, chunkSize, segmentHint);
         }
+        
+        currentPosition = Position(x[numSamples - 1], y[numSamples - 1]);
     }
     
     //==============================================================================
-    void moveToNextScanLine()
+    void wrapPhase()
     {
-        currentLine++;
+        const double length = activePath->getLength();
         
-        if (currentLine >= imageDimensions.height)
+        if (phase >= 0.0 && phase < length)
         {
-            // Completed full image scan
-            if (loopingEnabled)
-            {
-                // Reset to beginning for infinite loop
-                currentLine = 0;
-                currentPosition.y = 0.0f;
-                scanningRightToLeft = false;
-                currentPosition.x = 0.0f;
-            }
-            else
-            {
-                // Mark scan as complete
-                scanComplete = true;
-                currentLine = imageDimensions.height - 1;
-                currentPosition.y = static_cast<float>(currentLine);
-            }
+            return;
         }
-        else
+        
+        if (loopingEnabled)
         {
-            // Move to next scanline
-            currentPosition.y = static_cast<float>(currentLine);
-            
-            // Alternate scan direction for alternating scanline pattern
-            scanningRightToLeft = !scanningRightToLeft;
+            // Restart from the beginning for infinite looping
+            phase = std::fmod(phase, length);
             
-            if (scanningRightToLeft)
+            if (phase < 0.0)
             {
-                currentPosition.x = static_cast<float>(imageDimensions.width - 1);
-            }
-            else
-            {
-                currentPosition.x = 0.0f;
+                phase += length;
             }
         }
-    }
-    
-    //==============================================================================
-    void advanceVerticalScan(float speed)
-    {
-        // For now, just implement basic vertical scanning
-        // Full implementation would be similar to horizontal but moving vertically
-        currentPosition.y += speed;
-        
-        if (currentPosition.y >= static_cast<float>(imageDimensions.height - 1))
+        else if (phase >= length)
         {
-            if (loopingEnabled)
-            {
-                currentPosition.y = 0.0f;
-                currentPosition.x += 1.0f;
-                
-                if (currentPosition.x >= static_cast<float>(imageDimensions.width))
-                {
-                    currentPosition.x = 0.0f;
-                }
-            }
-            else
-            {
-                scanComplete = true;
-                currentPosition.y = static_cast<float>(imageDimensions.height - 1);
-            }
+            // Completed full image scan; stay at the end of the path
+            phase = length;
+            scanComplete = true;
+        }
+        else
+        {
+            phase = 0.0;
         }
-    }
-    
-    //==============================================================================
-    void advanceDiagonalScan(float speed)
-    {
-        // Placeholder for diagonal scanning
-        // For now, default to horizontal scanning
-        advanceHorizontalScan(speed);
-    }
-    
-    //==============================================================================
-    void advanceSpiralScan(float speed)
-    {
-        // Placeholder for spiral scanning
-        // For now, default to horizontal scanning
-        advanceHorizontalScan(speed);
     }
 };
 
@@ -259,4 +281,4 @@ private:
 std::unique_ptr<IImageScanner> createImageScanner()
 {
     return std::make_unique<ImageScanner>();
-}
\ No newline at end of file
+}
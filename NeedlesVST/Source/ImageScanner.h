@@ -1,50 +1,9 @@
 #pragma once
 
-#include <cmath>
 #include <memory>
-#include "AudioSynthesis.h"
+#include "ScanTypes.h"
 
-//==============================================================================
-/**
- * Position structure for 2D coordinates with sub-pixel precision
- */
-struct Position
-{
-    float x, y;
-    
-    Position(float xPos = 0.0f, float yPos = 0.0f) : x(xPos), y(yPos) {}
-    
-    bool operator==(const Position& other) const
-    {
-        return std::abs(x - other.x) < 0.001f && std::abs(y - other.y) < 0.001f;
-    }
-};
-
-//==============================================================================
-/**
- * Dimensions structure for width and height
- */
-struct Dimensions
-{
-    int width, height;
-    
-    Dimensions(int w = 0, int h = 0) : width(w), height(h) {}
-    
-    bool isValid() const { return width > 0 && height > 0; }
-    int getArea() const { return width * height; }
-};
-
-//==============================================================================
-/**
- * Scan pattern enumeration for different image traversal algorithms
- */
-enum class ScanPattern
-{
-    Horizontal = 0,     // Left-to-right, alternating scanlines
-    Vertical,           // Top-to-bottom, alternating columns
-    Diagonal,           // Diagonal sweeps across image
-    Spiral              // Spiral from center outward
-};
+struct ScanPathSet;
 
 //==============================================================================
 /**
@@ -62,6 +21,13 @@ public:
      */
     virtual void initialize(int width, int height) = 0;
     
+    /**
+     * Initialize scanner with paths compiled elsewhere (no allocation, audio thread safe)
+     * The path set must stay valid until the scanner is initialized again.
+     * @param paths Compiled paths of every pattern for the image
+     */
+    virtual void initialize(const ScanPathSet& paths) = 0;
+    
     /**
      * Get current scan position with sub-pixel precision
      * @return Current position coordinates
@@ -75,8 +41,48 @@ public:
      */
     virtual Position advancePosition(float speed) = 0;
     
+    /**
+     * Advance through a block of samples, writing the position after each step
+     * Equivalent to calling advancePosition once per sample.
+     * @param speeds Per-sample speed multipliers
+     * @param x Output array of X coordinates
+     * @param y Output array of Y coordinates
+     * @param numSamples Number of samples to advance
+     */
+    virtual void advancePositions(const float* speeds, float* x, float* y, int numSamples) = 0;
+    
+    /**
+     * Advance through a block of samples at a constant speed
+     * @param speed Speed multiplier for every sample
+     * @param x Output array of X coordinates
+     * @param y Output array of Y coordinates
+     * @param numSamples Number of samples to advance
+     */
+    virtual void advancePositions(float speed, float* x, float* y, int numSamples) = 0;
+    
+    /**
+     * Move to a distance along the current path in constant time
+     * Wraps around when looping, otherwise clamps to the path.
+     * @param arcLength Distance from the start of the path in pixels
+     */
+    virtual void setPhase(double arcLength) = 0;
+    
+    /**
+     * Get the current distance along the path
+     * @return Distance from the start of the path in pixels
+     */
+    virtual double getPhase() const = 0;
+    
+    /**
+     * Get the total length of the current path
+     * @return Path length in pixels, 0 if not initialized
+     */
+    virtual double getPathLength() const = 0;
+    
     /**
      * Set scanning pattern algorithm
+     * Call every block: a pattern whose path is still being built scans a
+     * stand-in, and the scanner moves over once it is ready.
      * @param pattern Pattern type to use for traversal
      */
     virtual void setScanPattern(ScanPattern pattern) = 0;
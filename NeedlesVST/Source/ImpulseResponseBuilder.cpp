@@ -0,0 +1,228 @@
+/*
+ * ImpulseResponseBuilder.cpp - Path sampling, response shaping and the build worker
+ */
+
+#include "ImpulseResponseBuilder.h"
+#include "AudioSynthesis.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+//==============================================================================
+ImpulseResponseBuilder::ImpulseResponseBuilder(const IImageLoader& imageLoader, std::function<void()> firstRequestCallback)
+    : loader(imageLoader), onFirstRequest(std::move(firstRequestCallback))
+{
+}
+
+ImpulseResponseBuilder::~ImpulseResponseBuilder()
+{
+    stopWorker();
+}
+
+void ImpulseResponseBuilder::setScanPaths(const ScanPathSet* scanPaths)
+{
+    paths = scanPaths;
+}
+
+void ImpulseResponseBuilder::startWorker()
+{
+    workerCancelled = false;
+    worker = std::thread([this] { run(); });
+}
+
+void ImpulseResponseBuilder::stopWorker()
+{
+    if (worker.joinable())
+    {
+        workerCancelled = true;
+        workerWake.signal();
+        worker.join();
+    }
+
+    // Forget the last request, so the next one starts the worker again
+    workerWake.reset();
+    requestedLength.store(0);
+    requestSerial.store(0);
+    finishedReady.store(false);
+}
+
+//==============================================================================
+void ImpulseResponseBuilder::request(const ImpulseResponseSettings& settings)
+{
+    if (settings == loadRequest())
+    {
+        return;
+    }
+
+    requestedPattern.store(static_cast<int>(settings.pattern));
+    requestedFormula.store(static_cast<int>(settings.formula));
+    requestedAreaSize.store(settings.areaSize);
+    requestedBlurShape.store(static_cast<int>(settings.blurShape));
+    requestedLength.store(settings.lengthSamples);
+
+    if (requestSerial.fetch_add(1) == 0 && onFirstRequest)
+    {
+        onFirstRequest();
+    }
+
+    workerWake.signal();
+}
+
+ImpulseResponseSettings ImpulseResponseBuilder::loadRequest() const
+{
+    ImpulseResponseSettings settings;
+    settings.pattern = static_cast<ScanPattern>(requestedPattern.load());
+    settings.formula = static_cast<ConversionFormula>(requestedFormula.load());
+    settings.areaSize = requestedAreaSize.load();
+    settings.blurShape = static_cast<BlurShape>(requestedBlurShape.load());
+    settings.lengthSamples = requestedLength.load();
+    return settings;
+}
+
+bool ImpulseResponseBuilder::takeImpulseResponse(juce::AudioBuffer<float>& destination)
+{
+    if (!finishedReady.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    std::swap(finished, destination);
+    finishedReady.store(false, std::memory_order_release);
+
+    // The mailbox is free for a response finished in the meantime
+    workerWake.signal();
+    return true;
+}
+
+//==============================================================================
+void ImpulseResponseBuilder::run()
+{
+    const auto isCancelled = [this] { return workerCancelled.load(); };
+
+    uint32_t builtSerial = 0;
+    juce::AudioBuffer<float> pending;
+    bool hasPending = false;
+
+    // Sleeps until the reader changes the settings or empties the mailbox
+    while (!isCancelled())
+    {
+        const uint32_t serial = requestSerial.load();
+
+        if (serial != builtSerial)
+        {
+            // Fields changed mid-read bump the serial again, so a torn read is just rebuilt
+            const ImpulseResponseSettings settings = loadRequest();
+
+            if (paths != nullptr && !paths->request(settings.pattern))
+            {
+                // Deferred paths don't signal when they finish, so look again shortly
+                workerWake.wait(deferredPathRetryMs);
+                continue;
+            }
+
+            builtSerial = serial;
+
+            if (settings.lengthSamples <= 0 || paths == nullptr)
+            {
+                continue;
+            }
+
+            // A newer request makes this build worthless, so drop it part way
+            const auto isSuperseded = [this, serial] { return workerCancelled.load() || requestSerial.load() != serial; };
+            juce::AudioBuffer<float> response(1, settings.lengthSamples);
+
+            if (render(loader, paths->get(settings.pattern), settings, response.getWritePointer(0), isSuperseded)
+                && !isSuperseded())
+            {
+                pending = std::move(response);
+                hasPending = true;
+            }
+
+            continue;
+        }
+
+        if (hasPending && !finishedReady.load(std::memory_order_acquire))
+        {
+            // Releases the buffer the reader swapped out last time
+            finished = std::move(pending);
+            hasPending = false;
+            finishedReady.store(true, std::memory_order_release);
+            continue;
+        }
+
+        workerWake.wait(-1);
+    }
+}
+
+//==============================================================================
+bool ImpulseResponseBuilder::render(const IImageLoader& loader, const ScanPath& path,
+                                    const ImpulseResponseSettings& settings, float* output,
+                                    const std::function<bool()>& shouldCancel)
+{
+    const int numSamples = settings.lengthSamples;
+
+    if (numSamples <= 0)
+    {
+        return true;
+    }
+
+    if (path.isEmpty())
+    {
+        std::fill(output, output + numSamples, 0.0f);
+        return true;
+    }
+
+    const auto synthesis = createAudioSynthesis();
+    const double step = path.getLength() / numSamples;
+
+    std::vector<double> arcLengths(renderBlockSize);
+    std::vector<float> x(renderBlockSize), y(renderBlockSize), areaSizes(renderBlockSize, settings.areaSize);
+    std::vector<uint8_t> red(renderBlockSize), green(renderBlockSize), blue(renderBlockSize);
+
+    int segmentHint = -1;
+    double sum = 0.0;
+
+    for (int start = 0; start < numSamples; start += renderBlockSize)
+    {
+        if (shouldCancel && shouldCancel())
+        {
+            return false;
+        }
+
+        const int blockSize = std::min(renderBlockSize, numSamples - start);
+
+        for (int i = 0; i < blockSize; ++i)
+        {
+            arcLengths[static_cast<size_t>(i)] = (start + i) * step;
+        }
+
+        path.getPositions(arcLengths.data(), x.data(), y.data(), blockSize, segmentHint);
+        loader.getAreaAverages(x.data(), y.data(), areaSizes.data(), blockSize,
+                               red.data(), green.data(), blue.data(), settings.blurShape);
+        synthesis->convertBlock(red.data(), green.data(), blue.data(), output + start, blockSize, settings.formula);
+
+        for (int i = 0; i < blockSize; ++i)
+        {
+            sum += output[start + i];
+        }
+    }
+
+    // The image's mean brightness would otherwise be a DC step in every convolution
+    const float mean = static_cast<float>(sum / numSamples);
+    const int fadeLength = std::max(1, static_cast<int>(static_cast<float>(numSamples) * fadeOutFraction));
+    const int fadeStart = numSamples - fadeLength;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        output[i] -= mean;
+    }
+
+    for (int i = 0; i < fadeLength; ++i)
+    {
+        const float fade = 0.5f * (1.0f + std::cos(juce::MathConstants<float>::pi * static_cast<float>(i + 1)
+                                                   / static_cast<float>(fadeLength)));
+        output[fadeStart + i] *= fade;
+    }
+
+    return true;
+}
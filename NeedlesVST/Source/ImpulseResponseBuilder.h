@@ -0,0 +1,134 @@
+/*
+ * ImpulseResponseBuilder.h - Impulse responses read along an image's scan paths
+ *
+ * For convolving the plugin's audio input, a scan path is played from start
+ * to end over the length of the impulse response, through the usual area
+ * averaging and conversion formula. Responses are rebuilt on a worker thread
+ * whenever the audio thread asks for different settings, and handed back
+ * through a single-slot mailbox without locking or allocating.
+ */
+
+#pragma once
+
+#include "ImageLoader.h"
+#include "ScanPath.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+//==============================================================================
+/**
+ * What an impulse response is read from
+ */
+struct ImpulseResponseSettings
+{
+    ScanPattern pattern {ScanPattern::Horizontal};
+    ConversionFormula formula {ConversionFormula::RGBAverage};
+    float areaSize {1.0f};
+    BlurShape blurShape {BlurShape::Box};
+    int lengthSamples {0};              // The whole path is spread over this length
+
+    bool operator==(const ImpulseResponseSettings& other) const
+    {
+        return pattern == other.pattern
+            && formula == other.formula
+            && areaSize == other.areaSize
+            && blurShape == other.blurShape
+            && lengthSamples == other.lengthSamples;
+    }
+
+    bool operator!=(const ImpulseResponseSettings& other) const { return !(*this == other); }
+};
+
+//==============================================================================
+/**
+ * Background builder of impulse responses for one loaded image
+ *
+ * Threading: setScanPaths(), startWorker() and stopWorker() run off the audio
+ * thread. request() and takeImpulseResponse() are real-time safe and are
+ * called from one reader thread; they wake the worker, which otherwise sleeps.
+ * The first request() calls onFirstRequest, so the owner can start the worker
+ * only once responses are actually wanted.
+ */
+class ImpulseResponseBuilder
+{
+public:
+    static constexpr int renderBlockSize = 4096;    // Path positions gathered per pass
+    static constexpr float fadeOutFraction = 0.1f;  // Tail faded so the end of the path doesn't click
+    static constexpr int deferredPathRetryMs = 10;  // Wait for a deferred path to finish compiling
+
+    /**
+     * @param loader Image read for every response; must outlive the builder
+     * @param onFirstRequest Called from the first request(); must be real-time safe. May be empty.
+     */
+    explicit ImpulseResponseBuilder(const IImageLoader& loader, std::function<void()> onFirstRequest = {});
+    ~ImpulseResponseBuilder();
+
+    /**
+     * Set the paths responses are read along (not real-time safe; stop the worker first)
+     * @param paths Paths compiled for the loaded image, or nullptr; must outlive the worker
+     */
+    void setScanPaths(const ScanPathSet* paths);
+
+    /**
+     * Start or stop the worker thread that builds requested responses
+     * Stopping also forgets the last request and any unread response.
+     */
+    void startWorker();
+    void stopWorker();
+
+    /**
+     * Ask for a response with these settings (real-time safe)
+     * Repeating the current settings does nothing.
+     * @param settings Path, formula, area, blur shape and length of the response
+     */
+    void request(const ImpulseResponseSettings& settings);
+
+    /**
+     * Collect the newest finished response, if any (real-time safe)
+     * The buffers are swapped, so whatever the destination held is released
+     * later on the worker thread.
+     * @param destination Buffer receiving a one-channel response
+     * @return true if a new response was swapped in
+     */
+    bool takeImpulseResponse(juce::AudioBuffer<float>& destination);
+
+    /**
+     * Read a response along a path (never call from the audio thread)
+     * @param loader Image to read
+     * @param path Compiled scan path, spread over the whole response
+     * @param settings Formula, area size, blur shape and length of the response
+     * @param output Array receiving settings.lengthSamples samples
+     * @param shouldCancel Polled between passes; may be empty
+     * @return false if the build was cancelled
+     */
+    static bool render(const IImageLoader& loader, const ScanPath& path, const ImpulseResponseSettings& settings,
+                       float* output, const std::function<bool()>& shouldCancel = {});
+
+private:
+    //==============================================================================
+    void run();
+    ImpulseResponseSettings loadRequest() const;
+
+    const IImageLoader& loader;
+    const ScanPathSet* paths {nullptr};
+    std::function<void()> onFirstRequest;
+
+    // Written only by request(); requestSerial is bumped after the fields
+    std::atomic<int> requestedPattern {0};
+    std::atomic<int> requestedFormula {0};
+    std::atomic<float> requestedAreaSize {1.0f};
+    std::atomic<int> requestedBlurShape {0};
+    std::atomic<int> requestedLength {0};
+    std::atomic<uint32_t> requestSerial {0};
+
+    // Owned by the worker while finishedReady is false, by the reader while it is true
+    juce::AudioBuffer<float> finished;
+    std::atomic<bool> finishedReady {false};
+
+    std::thread worker;
+    juce::WaitableEvent workerWake;
+    std::atomic<bool> workerCancelled {false};
+};
@@ -0,0 +1,431 @@
+/*
+ * NeedleBank.cpp - Needle layout, batch phase advancement and seeking
+ */
+
+#include "NeedleBank.h"
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+NeedleBank::NeedleBank()
+{
+    updateLayout();
+}
+
+void NeedleBank::prepare(int maxBlockSize)
+{
+    tableStride = std::max(0, maxBlockSize);
+    phaseTable.assign(static_cast<size_t>(maxNeedles) * static_cast<size_t>(tableStride), 0.0);
+    envelopeTable.assign(static_cast<size_t>(maxNeedles) * static_cast<size_t>(tableStride), 0.0f);
+}
+
+void NeedleBank::setSampleRate(double renderingRate)
+{
+    voiceRampSamples = std::max(1, static_cast<int>(std::lround(renderingRate * voiceRampSeconds)));
+}
+
+void NeedleBank::initialize(const ScanPathSet& pathSet)
+{
+    paths = &pathSet;
+    paths->request(pattern);
+    activePath = &paths->get(pattern);
+    restart();
+}
+
+void NeedleBank::setScanPattern(ScanPattern newPattern)
+{
+    pattern = newPattern;
+    
+    if (paths == nullptr)
+    {
+        return;
+    }
+    
+    // A deferred path scans its stand-in until it has been built, then takes over
+    paths->request(pattern);
+    const ScanPath* path = &paths->get(pattern);
+    
+    if (path != activePath)
+    {
+        activePath = path;
+        restart();
+    }
+}
+
+void NeedleBank::configure(int numNeedles, float detune, float spread)
+{
+    if (voiceMode)
+    {
+        return;
+    }
+    
+    const int count = std::clamp(numNeedles, 1, maxNeedles);
+    const bool countChanged = count != numActive;
+    
+    numActive = count;
+    detuneAmount = std::clamp(detune, 0.0f, 1.0f);
+    spreadAmount = std::clamp(spread, 0.0f, 1.0f);
+    updateLayout();
+    
+    if (countChanged)
+    {
+        // Keep needle 0 where it is so adding needles doesn't jump the scan
+        const double length = getPathLength();
+        
+        for (int needle = 1; needle < numActive; ++needle)
+        {
+            const size_t n = static_cast<size_t>(needle);
+            phases[n] = wrap(phases[0] + offsets[n] * length);
+            oscillatorPhases[n] = offsets[n];
+            segmentHints[n] = -1;
+        }
+    }
+}
+
+void NeedleBank::updateLayout()
+{
+    // Uncorrelated needles add in power, so the sum stays at the level of one needle
+    const float level = 1.0f / std::sqrt(static_cast<float>(numActive));
+    
+    for (int needle = 0; needle < numActive; ++needle)
+    {
+        const size_t n = static_cast<size_t>(needle);
+        
+        // Position of the needle across the bank, -1 to +1
+        const double position = numActive > 1 ? 2.0 * needle / (numActive - 1) - 1.0 : 0.0;
+        const float pan = spreadAmount * static_cast<float>(position);
+        
+        offsets[n] = static_cast<double>(needle) / numActive;
+        speedScales[n] = 1.0 + static_cast<double>(detuneAmount) * position;
+        gains[n].left = level * std::min(1.0f, 1.0f - pan);
+        gains[n].right = level * std::min(1.0f, 1.0f + pan);
+    }
+}
+
+void NeedleBank::restart()
+{
+    const double length = getPathLength();
+    
+    for (int needle = 0; needle < numActive; ++needle)
+    {
+        const size_t n = static_cast<size_t>(needle);
+        
+        if (voiceMode)
+        {
+            // Voice rates are in path cycles, so a new path keeps every pitch
+            phases[n] = 0.0;
+            speedScales[n] = getVoiceSpeedScale(needle);
+        }
+        else
+        {
+            // Needle oscillators start spread like the needles, so they don't sum in phase
+            phases[n] = wrap(offsets[n] * length);
+            oscillatorPhases[n] = offsets[n];
+        }
+    }
+    
+    segmentHints.fill(-1);
+}
+
+//==============================================================================
+void NeedleBank::setVoiceMode(bool shouldUseVoices)
+{
+    if (voiceMode == shouldUseVoices)
+    {
+        return;
+    }
+    
+    voiceMode = shouldUseVoices;
+    numActive = voiceMode ? 0 : 1;
+    releasing.fill(false);
+    ramping.fill(false);
+    
+    if (!voiceMode)
+    {
+        updateLayout();
+        restart();
+    }
+}
+
+void NeedleBank::setPitchedScanning(bool shouldPitchScan)
+{
+    if (pitchedScanning == shouldPitchScan)
+    {
+        return;
+    }
+    
+    pitchedScanning = shouldPitchScan;
+    
+    if (voiceMode)
+    {
+        for (int needle = 0; needle < numActive; ++needle)
+        {
+            speedScales[static_cast<size_t>(needle)] = getVoiceSpeedScale(needle);
+        }
+    }
+}
+
+double NeedleBank::getVoiceSpeedScale(int needle) const
+{
+    return pitchedScanning ? voiceRates[static_cast<size_t>(needle)] * getPathLength() : 1.0;
+}
+
+int NeedleBank::findVoice(int note) const
+{
+    for (int needle = 0; needle < numActive; ++needle)
+    {
+        if (notes[static_cast<size_t>(needle)] == note)
+        {
+            return needle;
+        }
+    }
+    
+    return -1;
+}
+
+void NeedleBank::startVoice(int note, double cyclesPerSample, float areaSize, float velocity)
+{
+    if (!voiceMode)
+    {
+        return;
+    }
+    
+    int voice = findVoice(note);
+    const bool isNewVoice = voice < 0 && numActive < maxNeedles;
+    
+    if (voice < 0)
+    {
+        if (numActive < maxNeedles)
+        {
+            voice = numActive++;
+        }
+        else
+        {
+            // Steal the voice that has been sounding longest
+            voice = static_cast<int>(std::min_element(voiceStarts.begin(), voiceStarts.end()) - voiceStarts.begin());
+        }
+    }
+    
+    // Each voice's level depends only on its own velocity, so starting or stopping a
+    // voice never changes the others. A retriggered or stolen voice ramps from where it is.
+    const size_t n = static_cast<size_t>(voice);
+    const float startLevel = isNewVoice ? 0.0f : envelopes[n].getCurrentValue();
+    
+    envelopes[n].reset(voiceRampSamples);
+    envelopes[n].setCurrentAndTargetValue(startLevel);
+    envelopes[n].setTargetValue(maxVoiceLevel * std::clamp(velocity, 0.0f, 1.0f));
+    releasing[n] = false;
+    
+    notes[n] = note;
+    voiceRates[n] = cyclesPerSample;
+    areaSizes[n] = areaSize;
+    voiceStarts[n] = ++voiceCounter;
+    gains[n] = Gains {startLevel, startLevel};
+    phases[n] = 0.0;
+    oscillatorPhases[n] = 0.0;
+    speedScales[n] = getVoiceSpeedScale(voice);
+    segmentHints[n] = -1;
+}
+
+void NeedleBank::stopVoice(int note)
+{
+    const int voice = voiceMode ? findVoice(note) : -1;
+    
+    if (voice < 0)
+    {
+        return;
+    }
+    
+    // The slot is freed by advance() once the voice has ramped out
+    const size_t n = static_cast<size_t>(voice);
+    releasing[n] = true;
+    envelopes[n].setTargetValue(0.0f);
+}
+
+void NeedleBank::stopAllVoices()
+{
+    if (!voiceMode)
+    {
+        return;
+    }
+    
+    for (int needle = 0; needle < numActive; ++needle)
+    {
+        const size_t n = static_cast<size_t>(needle);
+        releasing[n] = true;
+        envelopes[n].setTargetValue(0.0f);
+    }
+}
+
+void NeedleBank::freeReleasedVoices()
+{
+    // Keep sounding voices packed: the last one takes a freed slot
+    for (int needle = numActive - 1; needle >= 0; --needle)
+    {
+        const size_t n = static_cast<size_t>(needle);
+        
+        if (releasing[n] && !envelopes[n].isSmoothing())
+        {
+            --numActive;
+            
+            if (needle != numActive)
+            {
+                copyNeedle(numActive, needle);
+            }
+        }
+    }
+}
+
+void NeedleBank::updateEnvelopes(int numSamples)
+{
+    for (int needle = 0; needle < numActive; ++needle)
+    {
+        const size_t n = static_cast<size_t>(needle);
+        auto& envelope = envelopes[n];
+        
+        ramping[n] = envelope.isSmoothing();
+        
+        if (!ramping[n])
+        {
+            // Steady voices fold their level into the gains, so they cost nothing extra
+            const float level = envelope.getCurrentValue();
+            gains[n] = Gains {level, level};
+            continue;
+        }
+        
+        float* row = envelopeTable.data() + n * static_cast<size_t>(tableStride);
+        
+        for (int i = 0; i < numSamples; ++i)
+        {
+            row[i] = envelope.getNextValue();
+        }
+        
+        gains[n] = Gains {};
+    }
+}
+
+const float* NeedleBank::getEnvelope(int needle) const
+{
+    const size_t n = static_cast<size_t>(needle);
+    return ramping[n] ? envelopeTable.data() + n * static_cast<size_t>(tableStride) : nullptr;
+}
+
+void NeedleBank::copyNeedle(int from, int to)
+{
+    const size_t source = static_cast<size_t>(from);
+    const size_t target = static_cast<size_t>(to);
+    
+    phases[target] = phases[source];
+    offsets[target] = offsets[source];
+    speedScales[target] = speedScales[source];
+    segmentHints[target] = segmentHints[source];
+    gains[target] = gains[source];
+    oscillatorPhases[target] = oscillatorPhases[source];
+    voiceRates[target] = voiceRates[source];
+    areaSizes[target] = areaSizes[source];
+    notes[target] = notes[source];
+    voiceStarts[target] = voiceStarts[source];
+    envelopes[target] = envelopes[source];
+    releasing[target] = releasing[source];
+    ramping[target] = ramping[source];
+}
+
+//==============================================================================
+double NeedleBank::getPathLength() const
+{
+    return activePath != nullptr ? activePath->getLength() : 0.0;
+}
+
+double NeedleBank::wrap(double phase) const
+{
+    const double length = getPathLength();
+    
+    if (length <= 0.0)
+    {
+        return 0.0;
+    }
+    
+    return std::max(0.0, phase - length * std::floor(phase / length));
+}
+
+void NeedleBank::setPhase(double phase)
+{
+    const double length = getPathLength();
+    
+    for (int needle = 0; needle < numActive; ++needle)
+    {
+        const size_t n = static_cast<size_t>(needle);
+        phases[n] = wrap(phase * speedScales[n] + offsets[n] * length);
+    }
+}
+
+void NeedleBank::setOscillatorPhases(double cycles)
+{
+    for (int needle = 0; needle < numActive; ++needle)
+    {
+        const size_t n = static_cast<size_t>(needle);
+        const double phase = cycles * speedScales[n] + offsets[n];
+        oscillatorPhases[n] = phase - std::floor(phase);
+    }
+}
+
+//==============================================================================
+template <typename SpeedSource>
+void NeedleBank::advanceBlock(SpeedSource speedAt, int numSamples)
+{
+    if (voiceMode)
+    {
+        freeReleasedVoices();
+        updateEnvelopes(numSamples);
+    }
+    
+    const double length = getPathLength();
+    
+    if (length <= 0.0)
+    {
+        return;
+    }
+    
+    const double inverseLength = 1.0 / length;
+    
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const double speed = static_cast<double>(speedAt(i));
+        double* column = phaseTable.data() + i;
+        
+        // Vectorises across needles: the loop wrap is a floor, not a branch
+        for (int needle = 0; needle < numActive; ++needle)
+        {
+            const size_t n = static_cast<size_t>(needle);
+            const double phase = phases[n] + speed * speedScales[n];
+            
+            phases[n] = std::max(0.0, phase - length * std::floor(phase * inverseLength));
+            column[n * static_cast<size_t>(tableStride)] = phases[n];
+        }
+    }
+}
+
+void NeedleBank::advance(const float* speeds, int numSamples)
+{
+    advanceBlock([speeds](int i) { return speeds[i]; }, numSamples);
+}
+
+void NeedleBank::advance(float speed, int numSamples)
+{
+    advanceBlock([speed](int) { return speed; }, numSamples);
+}
+
+void NeedleBank::getPositions(int needle, float* x, float* y, int numSamples)
+{
+    if (activePath == nullptr || activePath->isEmpty())
+    {
+        std::fill(x, x + numSamples, 0.0f);
+        std::fill(y, y + numSamples, 0.0f);
+        return;
+    }
+    
+    const size_t n = static_cast<size_t>(needle);
+    const double* arcLengths = phaseTable.data() + n * static_cast<size_t>(tableStride);
+    
+    activePath->getPositions(arcLengths, x, y, numSamples, segmentHints[n]);
+}
@@ -0,0 +1,244 @@
+/*
+ * NeedleBank.h - Polyphonic scanning over one shared image
+ * 
+ * Runs up to maxNeedles scan heads over the compiled paths of a single image
+ * snapshot. Needle state is kept as structure-of-arrays, so every sample
+ * advances all needles in one loop that vectorises across needles, and the
+ * decoded pixels, area table and compiled paths are shared by all of them.
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "ScanPath.h"
+#include "ScanTypes.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+//==============================================================================
+/**
+ * Bank of needles scanning the same path at individual phases, speeds and pans
+ * 
+ * Needles are laid out symmetrically from the bank settings: needle i of N
+ * starts i / N of the way along the path, and its speed and pan are spread
+ * evenly across [-detune, +detune] and [-spread, +spread]. A bank of one
+ * needle scans exactly like a single IImageScanner.
+ * 
+ * In voice mode the needles are instead started and stopped by notes: each
+ * voice runs at its own rate in path cycles per sample, with an area size and
+ * level set on note-on. A voice ramps in from silence and, after note-off,
+ * keeps sounding until it has ramped out. Voices come from the fixed pool of
+ * maxNeedles slots, kept packed at the front so loops only visit sounding
+ * voices; when every slot is busy the oldest voice is stolen. Nothing allocates.
+ * 
+ * Audio thread usage per chunk: advance() once, then getPositions(),
+ * getGains() and getEnvelope() for each needle. All needles always loop.
+ */
+class NeedleBank
+{
+public:
+    static constexpr int maxNeedles = 32;
+    
+    // Attack and release time of a voice
+    static constexpr double voiceRampSeconds = 0.005;
+    
+    // Level of a voice at full velocity
+    static constexpr float maxVoiceLevel = 0.5f;
+    
+    /**
+     * Output gains of one needle: a balance law, so a centred needle is unity,
+     * scaled by the bank's 1 / sqrt(N) level normalisation
+     */
+    struct Gains
+    {
+        float left {1.0f};
+        float right {1.0f};
+    };
+    
+    NeedleBank();
+    
+    /**
+     * Allocate the phase and envelope tables (not real-time safe)
+     * @param maxBlockSize Largest chunk that will be passed to advance()
+     */
+    void prepare(int maxBlockSize);
+    
+    /**
+     * Set the rate advance() is called at, which sets the voice ramp length (real-time safe)
+     * Voices already ramping finish at their old rate.
+     * @param renderingRate Samples per second at which the needles are advanced
+     */
+    void setSampleRate(double renderingRate);
+    
+    /**
+     * Start scanning new paths; needles restart at their offsets
+     * @param paths Compiled paths, which must outlive the bank's use of them
+     */
+    void initialize(const ScanPathSet& paths);
+    
+    /**
+     * Switch every needle to another pattern; needles restart at their offsets
+     * Call every block: a pattern whose path is still being built scans a
+     * stand-in, and the needles move over once it is ready.
+     * @param pattern Scan pattern
+     */
+    void setScanPattern(ScanPattern pattern);
+    ScanPattern getScanPattern() const { return pattern; }
+    
+    /**
+     * Switch between free-running needles and note-triggered voices
+     * Entering voice mode silences the bank; leaving it restores one needle
+     * until configure() is called.
+     * @param shouldUseVoices True for voice mode
+     */
+    void setVoiceMode(bool shouldUseVoices);
+    bool isVoiceMode() const { return voiceMode; }
+    
+    /**
+     * Choose whether voices scan the path at their note rate
+     * When a voice's pitch comes from an oscillator instead, its needle scans
+     * at the common scan speed like a free-running needle.
+     * @param shouldPitchScan True to scan one path per note cycle (the default)
+     */
+    void setPitchedScanning(bool shouldPitchScan);
+    
+    /**
+     * Lay out the needles (real-time safe, ignored in voice mode)
+     * Changing the count respaces the needles around needle 0's current phase.
+     * @param numNeedles Number of active needles, clamped to [1, maxNeedles]
+     * @param detune Speed spread as a fraction of the scan speed (0 to 1)
+     * @param spread Pan spread (0 = all centred, 1 = outermost needles hard left/right)
+     */
+    void configure(int numNeedles, float detune, float spread);
+    
+    /**
+     * Start a voice from the start of the path, stealing the oldest if the pool is full
+     * A note that is already sounding is retriggered in place, ramping from its
+     * current level. Ignored outside voice mode.
+     * @param note Note number identifying the voice
+     * @param cyclesPerSample Rate in path lengths per sample, i.e. frequency / sample rate
+     * @param areaSize Area size of the voice in pixels
+     * @param velocity Note velocity (0 to 1), scaling the voice level
+     */
+    void startVoice(int note, double cyclesPerSample, float areaSize, float velocity);
+    
+    /**
+     * Release the voice playing a note, if any; it is freed once it has ramped out
+     * @param note Note number identifying the voice
+     */
+    void stopVoice(int note);
+    
+    /**
+     * Release every voice
+     */
+    void stopAllVoices();
+    
+    /**
+     * Advance all needles through a chunk
+     * @param speeds Scan speed for each sample, scaled by each needle's detune
+     * @param numSamples Number of samples, at most the prepared block size
+     */
+    void advance(const float* speeds, int numSamples);
+    
+    /**
+     * Advance all needles through a chunk at a constant speed
+     * @param speed Scan speed for every sample, scaled by each needle's detune
+     * @param numSamples Number of samples, at most the prepared block size
+     */
+    void advance(float speed, int numSamples);
+    
+    /**
+     * Seek all needles in constant time
+     * Needle i moves to phase * speedScale(i) + offset(i), which is where
+     * advancing from zero at a constant speed would have taken it.
+     * @param phase Distance along the path of an undetuned needle at offset 0
+     */
+    void setPhase(double phase);
+    
+    /**
+     * Get the positions of one needle over the last advanced chunk
+     * @param needle Needle index, less than getNumNeedles()
+     * @param x Output X coordinates
+     * @param y Output Y coordinates
+     * @param numSamples Number of samples passed to the last advance()
+     */
+    void getPositions(int needle, float* x, float* y, int numSamples);
+    
+    int getNumNeedles() const { return numActive; }
+    double getPhase(int needle) const { return phases[static_cast<size_t>(needle)]; }
+    Gains getGains(int needle) const { return gains[static_cast<size_t>(needle)]; }
+    
+    /**
+     * Get the level of a voice over the last advanced chunk while it ramps
+     * @param needle Needle index, less than getNumNeedles()
+     * @return Per-sample level to apply on top of getGains(), or nullptr when the
+     *         level is steady and already included in getGains()
+     */
+    const float* getEnvelope(int needle) const;
+    float getAreaSize(int needle) const { return areaSizes[static_cast<size_t>(needle)]; }
+    int getNote(int needle) const { return notes[static_cast<size_t>(needle)]; }
+    double getSpeedScale(int needle) const { return speedScales[static_cast<size_t>(needle)]; }
+    double getVoiceRate(int needle) const { return voiceRates[static_cast<size_t>(needle)]; }
+    
+    // Oscillator phase in cycles, for needles that drive an oscillator of their own
+    double getOscillatorPhase(int needle) const { return oscillatorPhases[static_cast<size_t>(needle)]; }
+    void setOscillatorPhase(int needle, double phase) { oscillatorPhases[static_cast<size_t>(needle)] = phase; }
+    
+    /**
+     * Seek all needle oscillators in constant time
+     * Oscillator i moves to cycles * speedScale(i) + offset(i), wrapped to one
+     * cycle, the oscillator counterpart of setPhase().
+     * @param cycles Oscillator phase of an undetuned needle at offset 0
+     */
+    void setOscillatorPhases(double cycles);
+
+private:
+    //==============================================================================
+    template <typename SpeedSource>
+    void advanceBlock(SpeedSource speedAt, int numSamples);
+    
+    void restart();
+    void updateEnvelopes(int numSamples);
+    void freeReleasedVoices();
+    void copyNeedle(int from, int to);
+    int findVoice(int note) const;
+    void updateLayout();
+    double wrap(double phase) const;
+    double getPathLength() const;
+    double getVoiceSpeedScale(int needle) const;
+    
+    const ScanPathSet* paths {nullptr};
+    const ScanPath* activePath {nullptr};
+    ScanPattern pattern {ScanPattern::Horizontal};
+    
+    int numActive {1};
+    bool voiceMode {false};
+    bool pitchedScanning {true};
+    uint64_t voiceCounter {0};
+    float detuneAmount {0.0f};
+    float spreadAmount {0.0f};
+    
+    // Per-needle state, structure-of-arrays
+    std::array<double, maxNeedles> phases {};
+    std::array<double, maxNeedles> offsets {};      // Fraction of the path length
+    std::array<double, maxNeedles> speedScales {};
+    std::array<int, maxNeedles> segmentHints {};
+    std::array<Gains, maxNeedles> gains {};
+    std::array<double, maxNeedles> oscillatorPhases {};
+    
+    // Voice state, only meaningful in voice mode
+    std::array<double, maxNeedles> voiceRates {};   // Path cycles per sample
+    std::array<float, maxNeedles> areaSizes {};
+    std::array<int, maxNeedles> notes {};
+    std::array<uint64_t, maxNeedles> voiceStarts {};  // Start order, for stealing
+    std::array<juce::SmoothedValue<float>, maxNeedles> envelopes;
+    std::array<bool, maxNeedles> releasing {};
+    std::array<bool, maxNeedles> ramping {};        // Envelope row valid for the last chunk
+    int voiceRampSamples {0};
+    
+    // Phases and voice levels of the last advanced chunk, one row of tableStride per needle
+    std::vector<double> phaseTable;
+    std::vector<float> envelopeTable;
+    int tableStride {0};
+};
@@ -42,67 +42,199 @@ float ParameterManager::getBluePan() const
     return bluePan.load();
 }
 
+ConversionFormula ParameterManager::getConversionFormula() const
+{
+    return static_cast<ConversionFormula>(conversionFormula.load());
+}
+
+ScanPattern ParameterManager::getScanPattern() const
+{
+    return static_cast<ScanPattern>(scanPattern.load());
+}
+
+BlurShape ParameterManager::getBlurShape() const
+{
+    return static_cast<BlurShape>(blurShape.load());
+}
+
+TransportSync ParameterManager::getTransportSync() const
+{
+    return static_cast<TransportSync>(transportSync.load());
+}
+
+int ParameterManager::getNumNeedles() const
+{
+    return numNeedles.load();
+}
+
+float ParameterManager::getNeedleDetune() const
+{
+    return needleDetune.load();
+}
+
+float ParameterManager::getNeedleSpread() const
+{
+    return needleSpread.load();
+}
+
+TriggerMode ParameterManager::getTriggerMode() const
+{
+    return static_cast<TriggerMode>(triggerMode.load());
+}
+
+OversamplingFactor ParameterManager::getOversampling() const
+{
+    return static_cast<OversamplingFactor>(oversampling.load());
+}
+
+SynthesisMode ParameterManager::getSynthesisMode() const
+{
+    return static_cast<SynthesisMode>(synthesisMode.load());
+}
+
+float ParameterManager::getWavetableFrequency() const
+{
+    return wavetableFrequency.load();
+}
+
+float ParameterManager::getSpectrogramSpeed() const
+{
+    return spectrogramSpeed.load();
+}
+
+float ParameterManager::getImpulseLength() const
+{
+    return impulseLength.load();
+}
+
+float ParameterManager::getConvolutionMix() const
+{
+    return convolutionMix.load();
+}
+
+//==============================================================================
+void ParameterManager::bindParameters(juce::AudioProcessorValueTreeState& parameters)
+{
+    // String-keyed lookups happen here only, never per block or per sample
+    bound.scanSpeed = parameters.getRawParameterValue("scanSpeed");
+    bound.areaSize = parameters.getRawParameterValue("areaSize");
+    bound.outputGain = parameters.getRawParameterValue("outputGain");
+    bound.leftWeight = parameters.getRawParameterValue("leftWeight");
+    bound.rightWeight = parameters.getRawParameterValue("rightWeight");
+    bound.redPan = parameters.getRawParameterValue("redPan");
+    bound.greenPan = parameters.getRawParameterValue("greenPan");
+    bound.bluePan = parameters.getRawParameterValue("bluePan");
+    bound.conversionFormula = parameters.getRawParameterValue("conversionFormula");
+    bound.scanPattern = parameters.getRawParameterValue("scanPattern");
+    bound.blurShape = parameters.getRawParameterValue("blurShape");
+    bound.transportSync = parameters.getRawParameterValue("transportSync");
+    bound.needleCount = parameters.getRawParameterValue("needleCount");
+    bound.needleDetune = parameters.getRawParameterValue("needleDetune");
+    bound.needleSpread = parameters.getRawParameterValue("needleSpread");
+    bound.triggerMode = parameters.getRawParameterValue("triggerMode");
+    bound.oversampling = parameters.getRawParameterValue("oversampling");
+    bound.synthesisMode = parameters.getRawParameterValue("synthesisMode");
+    bound.wavetableFrequency = parameters.getRawParameterValue("wavetableFrequency");
+    bound.spectrogramSpeed = parameters.getRawParameterValue("spectrogramSpeed");
+    bound.impulseLength = parameters.getRawParameterValue("impulseLength");
+    bound.convolutionMix = parameters.getRawParameterValue("convolutionMix");
+    
+    boundState = &parameters;
+}
+
+float ParameterManager::loadValue(const std::atomic<float>* value, float fallback)
+{
+    return value != nullptr ? value->load() : fallback;
+}
+
 void ParameterManager::updateFromValueTreeState(juce::AudioProcessorValueTreeState& parameters)
 {
-    // Core parameters
-    float newScanSpeed = *parameters.getRawParameterValue("scanSpeed");
-    float newAreaSize = static_cast<float>(*parameters.getRawParameterValue("areaSize"));
-    float newOutputGain = *parameters.getRawParameterValue("outputGain");
-    float newLeftWeight = *parameters.getRawParameterValue("leftWeight");
-    float newRightWeight = *parameters.getRawParameterValue("rightWeight");
+    if (boundState != &parameters)
+    {
+        bindParameters(parameters);
+    }
     
-    // RGB pan parameters
-    float newRedPan = *parameters.getRawParameterValue("redPan");
-    float newGreenPan = *parameters.getRawParameterValue("greenPan");
-    float newBluePan = *parameters.getRawParameterValue("bluePan");
+    ParameterSnapshot next;
     
-    // Check for changes
-    bool changed = false;
+    // Core parameters
+    next.scanSpeed = loadValue(bound.scanSpeed, snapshot.scanSpeed);
+    next.areaSize = static_cast<int>(loadValue(bound.areaSize, static_cast<float>(snapshot.areaSize)));
+    next.outputGain = loadValue(bound.outputGain, snapshot.outputGain);
+    next.leftChannelWeight = loadValue(bound.leftWeight, snapshot.leftChannelWeight);
+    next.rightChannelWeight = loadValue(bound.rightWeight, snapshot.rightChannelWeight);
     
-    if (scanSpeed.load() != newScanSpeed) {
-        scanSpeed.store(newScanSpeed);
-        changed = true;
-    }
+    // RGB pan parameters
+    next.redPan = loadValue(bound.redPan, snapshot.redPan);
+    next.greenPan = loadValue(bound.greenPan, snapshot.greenPan);
+    next.bluePan = loadValue(bound.bluePan, snapshot.bluePan);
     
-    if (areaSize.load() != newAreaSize) {
-        areaSize.store(newAreaSize);
-        changed = true;
-    }
+    // Choice parameters hold their index as a float
+    next.conversionFormula = static_cast<ConversionFormula>(juce::roundToInt(
+        loadValue(bound.conversionFormula, static_cast<float>(snapshot.conversionFormula))));
+    next.scanPattern = static_cast<ScanPattern>(juce::roundToInt(
+        loadValue(bound.scanPattern, static_cast<float>(snapshot.scanPattern))));
+    next.blurShape = static_cast<BlurShape>(juce::roundToInt(
+        loadValue(bound.blurShape, static_cast<float>(snapshot.blurShape))));
+    next.transportSync = static_cast<TransportSync>(juce::roundToInt(
+        loadValue(bound.transportSync, static_cast<float>(snapshot.transportSync))));
     
-    if (outputGain.load() != newOutputGain) {
-        outputGain.store(newOutputGain);
-        changed = true;
-    }
+    // Polyphonic scanning
+    next.numNeedles = juce::roundToInt(loadValue(bound.needleCount, static_cast<float>(snapshot.numNeedles)));
+    next.needleDetune = loadValue(bound.needleDetune, snapshot.needleDetune);
+    next.needleSpread = loadValue(bound.needleSpread, snapshot.needleSpread);
+    next.triggerMode = static_cast<TriggerMode>(juce::roundToInt(
+        loadValue(bound.triggerMode, static_cast<float>(snapshot.triggerMode))));
+    next.oversampling = static_cast<OversamplingFactor>(juce::roundToInt(
+        loadValue(bound.oversampling, static_cast<float>(snapshot.oversampling))));
     
-    if (leftChannelWeight.load() != newLeftWeight) {
-        leftChannelWeight.store(newLeftWeight);
-        changed = true;
-    }
+    // Wavetable synthesis
+    next.synthesisMode = static_cast<SynthesisMode>(juce::roundToInt(
+        loadValue(bound.synthesisMode, static_cast<float>(snapshot.synthesisMode))));
+    next.wavetableFrequency = loadValue(bound.wavetableFrequency, snapshot.wavetableFrequency);
+    next.spectrogramSpeed = loadValue(bound.spectrogramSpeed, snapshot.spectrogramSpeed);
     
-    if (rightChannelWeight.load() != newRightWeight) {
-        rightChannelWeight.store(newRightWeight);
-        changed = true;
-    }
+    // Input convolution
+    next.impulseLength = loadValue(bound.impulseLength, snapshot.impulseLength);
+    next.convolutionMix = loadValue(bound.convolutionMix, snapshot.convolutionMix);
     
-    // RGB pan parameter updates
-    if (redPan.load() != newRedPan) {
-        redPan.store(newRedPan);
-        changed = true;
+    // Check for changes
+    if (next == snapshot)
+    {
+        return;
     }
     
-    if (greenPan.load() != newGreenPan) {
-        greenPan.store(newGreenPan);
-        changed = true;
-    }
+    snapshot = next;
     
-    if (bluePan.load() != newBluePan) {
-        bluePan.store(newBluePan);
-        changed = true;
-    }
+    // Mirror into the atomics used by the thread-safe getters
+    scanSpeed.store(snapshot.scanSpeed);
+    areaSize.store(static_cast<float>(snapshot.areaSize));
+    outputGain.store(snapshot.outputGain);
+    leftChannelWeight.store(snapshot.leftChannelWeight);
+    rightChannelWeight.store(snapshot.rightChannelWeight);
+    redPan.store(snapshot.redPan);
+    greenPan.store(snapshot.greenPan);
+    bluePan.store(snapshot.bluePan);
+    conversionFormula.store(static_cast<int>(snapshot.conversionFormula));
+    scanPattern.store(static_cast<int>(snapshot.scanPattern));
+    blurShape.store(static_cast<int>(snapshot.blurShape));
+    transportSync.store(static_cast<int>(snapshot.transportSync));
+    numNeedles.store(snapshot.numNeedles);
+    needleDetune.store(snapshot.needleDetune);
+    needleSpread.store(snapshot.needleSpread);
+    triggerMode.store(static_cast<int>(snapshot.triggerMode));
+    oversampling.store(static_cast<int>(snapshot.oversampling));
+    synthesisMode.store(static_cast<int>(snapshot.synthesisMode));
+    wavetableFrequency.store(snapshot.wavetableFrequency);
+    spectrogramSpeed.store(snapshot.spectrogramSpeed);
+    impulseLength.store(snapshot.impulseLength);
+    convolutionMix.store(snapshot.convolutionMix);
     
-    if (changed) {
-        parametersChanged.store(true);
-    }
+    parametersChanged.store(true);
+}
+
+const ParameterSnapshot& ParameterManager::getSnapshot() const
+{
+    return snapshot;
 }
 
 bool ParameterManager::hasParametersChanged()
@@ -1,8 +1,110 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "AudioSynthesis.h"
+#include "ScanTypes.h"
+#include "ImageLoader.h"
 #include <atomic>
 
+//==============================================================================
+/**
+ * Internal oversampling of the needle render
+ */
+enum class OversamplingFactor
+{
+    Off = 0,
+    TwoTimes,
+    FourTimes,
+    EightTimes
+};
+
+//==============================================================================
+/**
+ * How needles turn image data into sound
+ */
+enum class SynthesisMode
+{
+    Scan = 0,           // Needles play the pixels they pass, sample by sample
+    WavetableRows,      // Each row is a single-cycle wavetable; needles select and morph
+    WavetableColumns,   // Each column is a single-cycle wavetable; needles select and morph
+    Spectrogram,        // Columns are magnitude spectra, resynthesised by inverse FFT
+    Convolution         // The input is convolved with a response read along the scan path
+};
+
+//==============================================================================
+/**
+ * Immutable copy of all parameter values, taken once per audio block
+ * 
+ * The audio thread reads parameters through a snapshot so every stage of a
+ * block sees consistent values and no string-keyed lookups happen per sample.
+ */
+struct ParameterSnapshot
+{
+    float scanSpeed {1.0f};
+    int areaSize {5};
+    float outputGain {1.0f};
+    float leftChannelWeight {0.5f};
+    float rightChannelWeight {0.5f};
+    
+    // RGB pan positions in percent (-100.0 to +100.0)
+    float redPan {0.0f};
+    float greenPan {0.0f};
+    float bluePan {0.0f};
+    
+    ConversionFormula conversionFormula {ConversionFormula::RGBAverage};
+    ScanPattern scanPattern {ScanPattern::Horizontal};
+    BlurShape blurShape {BlurShape::Box};
+    TransportSync transportSync {TransportSync::FreeRunning};
+    
+    // Polyphonic scanning
+    int numNeedles {1};
+    float needleDetune {0.0f};  // Percent of the scan speed (0 to 50)
+    float needleSpread {0.0f};  // Percent pan spread (0 to 100)
+    TriggerMode triggerMode {TriggerMode::FreeRunning};
+    
+    OversamplingFactor oversampling {OversamplingFactor::Off};
+    
+    // Wavetable synthesis
+    SynthesisMode synthesisMode {SynthesisMode::Scan};
+    float wavetableFrequency {110.0f};  // Hz, for free-running needles
+    float spectrogramSpeed {40.0f};     // Image columns per second
+    
+    // Input convolution
+    float impulseLength {1.5f};         // Seconds
+    float convolutionMix {100.0f};      // Wet percentage
+    
+    bool operator==(const ParameterSnapshot& other) const
+    {
+        return scanSpeed == other.scanSpeed
+            && areaSize == other.areaSize
+            && outputGain == other.outputGain
+            && leftChannelWeight == other.leftChannelWeight
+            && rightChannelWeight == other.rightChannelWeight
+            && redPan == other.redPan
+            && greenPan == other.greenPan
+            && bluePan == other.bluePan
+            && conversionFormula == other.conversionFormula
+            && scanPattern == other.scanPattern
+            && blurShape == other.blurShape
+            && transportSync == other.transportSync
+            && numNeedles == other.numNeedles
+            && needleDetune == other.needleDetune
+            && needleSpread == other.needleSpread
+            && triggerMode == other.triggerMode
+            && oversampling == other.oversampling
+            && synthesisMode == other.synthesisMode
+            && wavetableFrequency == other.wavetableFrequency
+            && spectrogramSpeed == other.spectrogramSpeed
+            && impulseLength == other.impulseLength
+            && convolutionMix == other.convolutionMix;
+    }
+    
+    bool operator!=(const ParameterSnapshot& other) const
+    {
+        return !(*this == other);
+    }
+};
+
 //==============================================================================
 /**
  * Parameter manager interface for thread-safe parameter access
@@ -60,12 +162,109 @@ public:
      */
     virtual float getBluePan() const = 0;
     
+    /**
+     * Get selected RGB-to-audio conversion formula
+     * @return Conversion formula
+     */
+    virtual ConversionFormula getConversionFormula() const = 0;
+    
+    /**
+     * Get selected scan pattern
+     * @return Scan pattern
+     */
+    virtual ScanPattern getScanPattern() const = 0;
+    
+    /**
+     * Get selected area averaging window shape
+     * @return Blur shape
+     */
+    virtual BlurShape getBlurShape() const = 0;
+    
+    /**
+     * Get selected scan phase source
+     * @return Transport sync mode
+     */
+    virtual TransportSync getTransportSync() const = 0;
+    
+    /**
+     * Get number of simultaneous needles
+     * @return Needle count (1 to 32)
+     */
+    virtual int getNumNeedles() const = 0;
+    
+    /**
+     * Get needle speed spread
+     * @return Detune in percent of the scan speed (0.0 to 50.0)
+     */
+    virtual float getNeedleDetune() const = 0;
+    
+    /**
+     * Get needle pan spread
+     * @return Spread in percent (0.0 to 100.0)
+     */
+    virtual float getNeedleSpread() const = 0;
+    
+    /**
+     * Get what starts the needles
+     * @return Trigger mode
+     */
+    virtual TriggerMode getTriggerMode() const = 0;
+    
+    /**
+     * Get the internal oversampling factor
+     * @return Oversampling setting
+     */
+    virtual OversamplingFactor getOversampling() const = 0;
+    
+    /**
+     * Get how needles turn image data into sound
+     * @return Synthesis mode
+     */
+    virtual SynthesisMode getSynthesisMode() const = 0;
+    
+    /**
+     * Get the oscillator frequency of free-running wavetable needles
+     * @return Frequency in Hz (20.0 to 2000.0)
+     */
+    virtual float getWavetableFrequency() const = 0;
+    
+    /**
+     * Get the playhead speed of spectrogram playback
+     * @return Image columns per second (1.0 to 1000.0)
+     */
+    virtual float getSpectrogramSpeed() const = 0;
+    
+    /**
+     * Get the length of impulse responses read from the image
+     * @return Length in seconds (0.05 to 6.0)
+     */
+    virtual float getImpulseLength() const = 0;
+    
+    /**
+     * Get the wet share of the input convolution
+     * @return Mix percentage (0.0 to 100.0)
+     */
+    virtual float getConvolutionMix() const = 0;
+    
+    /**
+     * Resolve and cache the raw parameter value pointers (call once, off the audio thread)
+     * @param parameters JUCE parameter state
+     */
+    virtual void bindParameters(juce::AudioProcessorValueTreeState& parameters) = 0;
+    
     /**
      * Update parameter values from ValueTreeState (called from audio thread)
+     * Reads through the bound pointers; binds first if bindParameters was not called.
      * @param parameters JUCE parameter state
      */
     virtual void updateFromValueTreeState(juce::AudioProcessorValueTreeState& parameters) = 0;
     
+    /**
+     * Get the snapshot taken by the last updateFromValueTreeState call
+     * @return Parameter snapshot (audio thread only)
+     */
+    virtual const ParameterSnapshot& getSnapshot() const = 0;
+    
     /**
      * Check if any parameters have changed since last check
      * @return true if parameters were updated
@@ -92,10 +291,61 @@ public:
     float getRedPan() const override;
     float getGreenPan() const override;
     float getBluePan() const override;
+    ConversionFormula getConversionFormula() const override;
+    ScanPattern getScanPattern() const override;
+    BlurShape getBlurShape() const override;
+    TransportSync getTransportSync() const override;
+    int getNumNeedles() const override;
+    float getNeedleDetune() const override;
+    float getNeedleSpread() const override;
+    TriggerMode getTriggerMode() const override;
+    OversamplingFactor getOversampling() const override;
+    SynthesisMode getSynthesisMode() const override;
+    float getWavetableFrequency() const override;
+    float getSpectrogramSpeed() const override;
+    float getImpulseLength() const override;
+    float getConvolutionMix() const override;
+    void bindParameters(juce::AudioProcessorValueTreeState& parameters) override;
     void updateFromValueTreeState(juce::AudioProcessorValueTreeState& parameters) override;
+    const ParameterSnapshot& getSnapshot() const override;
     bool hasParametersChanged() override;
     
 private:
+    // Raw parameter values resolved once by bindParameters
+    struct BoundParameters
+    {
+        std::atomic<float>* scanSpeed {nullptr};
+        std::atomic<float>* areaSize {nullptr};
+        std::atomic<float>* outputGain {nullptr};
+        std::atomic<float>* leftWeight {nullptr};
+        std::atomic<float>* rightWeight {nullptr};
+        std::atomic<float>* redPan {nullptr};
+        std::atomic<float>* greenPan {nullptr};
+        std::atomic<float>* bluePan {nullptr};
+        std::atomic<float>* conversionFormula {nullptr};
+        std::atomic<float>* scanPattern {nullptr};
+        std::atomic<float>* blurShape {nullptr};
+        std::atomic<float>* transportSync {nullptr};
+        std::atomic<float>* needleCount {nullptr};
+        std::atomic<float>* needleDetune {nullptr};
+        std::atomic<float>* needleSpread {nullptr};
+        std::atomic<float>* triggerMode {nullptr};
+        std::atomic<float>* oversampling {nullptr};
+        std::atomic<float>* synthesisMode {nullptr};
+        std::atomic<float>* wavetableFrequency {nullptr};
+        std::atomic<float>* spectrogramSpeed {nullptr};
+        std::atomic<float>* impulseLength {nullptr};
+        std::atomic<float>* convolutionMix {nullptr};
+    };
+    
+    static float loadValue(const std::atomic<float>* value, float fallback);
+    
+    const juce::AudioProcessorValueTreeState* boundState {nullptr};
+    BoundParameters bound;
+    
+    // Latest snapshot, written and read by the audio thread only
+    ParameterSnapshot snapshot;
+    
     // Atomic parameters for thread-safe access
     std::atomic<float> scanSpeed{1.0f};
     std::atomic<float> areaSize{5.0f};
@@ -108,6 +358,21 @@ private:
     std::atomic<float> greenPan{0.0f};
     std::atomic<float> bluePan{0.0f};
     
+    std::atomic<int> conversionFormula{0};
+    std::atomic<int> scanPattern{0};
+    std::atomic<int> blurShape{0};
+    std::atomic<int> transportSync{0};
+    std::atomic<int> numNeedles{1};
+    std::atomic<float> needleDetune{0.0f};
+    std::atomic<float> needleSpread{0.0f};
+    std::atomic<int> triggerMode{0};
+    std::atomic<int> oversampling{0};
+    std::atomic<int> synthesisMode{0};
+    std::atomic<float> wavetableFrequency{110.0f};
+    std::atomic<float> spectrogramSpeed{40.0f};
+    std::atomic<float> impulseLength{1.5f};
+    std::atomic<float> convolutionMix{100.0f};
+    
     // Change tracking
     std::atomic<bool> parametersChanged{false};
 };
@@ -0,0 +1,115 @@
+/*
+ * ParameterSmoother.cpp - Sample-accurate parameter smoothing implementation
+ */
+
+#include "ParameterSmoother.h"
+
+//==============================================================================
+void ParameterSmoother::prepare(double sampleRate, int maxBlockSize, double rampSeconds)
+{
+    capacity = juce::jmax(0, maxBlockSize);
+    rampDuration = rampSeconds;
+    
+    for (size_t i = 0; i < numParameters; ++i)
+    {
+        smoothers[i].reset(sampleRate, rampSeconds);
+        ramps[i].assign(static_cast<size_t>(capacity), 0.0f);
+        rampActive[i] = false;
+    }
+}
+
+void ParameterSmoother::setSampleRate(double sampleRate)
+{
+    for (auto& smoother : smoothers)
+    {
+        // SmoothedValue::reset snaps to the target, so restore the ramp in progress
+        const float current = smoother.getCurrentValue();
+        const float target = smoother.getTargetValue();
+        
+        smoother.reset(sampleRate, rampDuration);
+        smoother.setCurrentAndTargetValue(current);
+        smoother.setTargetValue(target);
+    }
+}
+
+void ParameterSmoother::reset(const ParameterSnapshot& snapshot)
+{
+    const auto values = getValues(snapshot);
+    
+    for (size_t i = 0; i < numParameters; ++i)
+    {
+        smoothers[i].setCurrentAndTargetValue(values[i]);
+    }
+}
+
+void ParameterSmoother::setTargets(const ParameterSnapshot& snapshot)
+{
+    const auto values = getValues(snapshot);
+    
+    for (size_t i = 0; i < numParameters; ++i)
+    {
+        smoothers[i].setTargetValue(values[i]);
+    }
+}
+
+//==============================================================================
+void ParameterSmoother::process(int numSamples)
+{
+    jassert(numSamples <= capacity);
+    numSamples = juce::jmin(numSamples, capacity);
+    
+    for (size_t i = 0; i < numParameters; ++i)
+    {
+        auto& smoother = smoothers[i];
+        float* ramp = ramps[i].data();
+        
+        rampActive[i] = smoother.isSmoothing();
+        
+        if (!rampActive[i])
+        {
+            // Settled parameters become a constant vector
+            juce::FloatVectorOperations::fill(ramp, smoother.getTargetValue(), numSamples);
+            continue;
+        }
+        
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            ramp[sample] = smoother.getNextValue();
+        }
+    }
+}
+
+//==============================================================================
+const float* ParameterSmoother::getRamp(SmoothedParameter parameter) const
+{
+    return ramps[static_cast<size_t>(parameter)].data();
+}
+
+bool ParameterSmoother::isSmoothing(SmoothedParameter parameter) const
+{
+    return rampActive[static_cast<size_t>(parameter)];
+}
+
+float ParameterSmoother::getTargetValue(SmoothedParameter parameter) const
+{
+    return smoothers[static_cast<size_t>(parameter)].getTargetValue();
+}
+
+//==============================================================================
+std::array<float, ParameterSmoother::numParameters> ParameterSmoother::getValues(
+    const ParameterSnapshot& snapshot)
+{
+    std::array<float, numParameters> values {};
+    
+    values[static_cast<size_t>(SmoothedParameter::ScanSpeed)] = snapshot.scanSpeed;
+    values[static_cast<size_t>(SmoothedParameter::AreaSize)] = static_cast<float>(snapshot.areaSize);
+    values[static_cast<size_t>(SmoothedParameter::OutputGain)] = snapshot.outputGain;
+    values[static_cast<size_t>(SmoothedParameter::LeftWeight)] = snapshot.leftChannelWeight;
+    values[static_cast<size_t>(SmoothedParameter::RightWeight)] = snapshot.rightChannelWeight;
+    values[static_cast<size_t>(SmoothedParameter::RedPan)] = snapshot.redPan;
+    values[static_cast<size_t>(SmoothedParameter::GreenPan)] = snapshot.greenPan;
+    values[static_cast<size_t>(SmoothedParameter::BluePan)] = snapshot.bluePan;
+    values[static_cast<size_t>(SmoothedParameter::ConvolutionMix)] = snapshot.convolutionMix * 0.01f;  // Wet fraction
+    
+    return values;
+}
@@ -0,0 +1,114 @@
+/*
+ * ParameterSmoother.h - Sample-accurate smoothing of continuous parameters
+ * 
+ * Ramps every continuous parameter towards its latest snapshot value and
+ * exposes each block's ramp as a filled float array, so render stages consume
+ * plain vectors instead of reading or branching on parameters per sample.
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "ParameterManager.h"
+
+#include <array>
+#include <vector>
+
+//==============================================================================
+/**
+ * Continuous parameters handled by ParameterSmoother
+ */
+enum class SmoothedParameter
+{
+    ScanSpeed = 0,
+    AreaSize,
+    OutputGain,
+    LeftWeight,
+    RightWeight,
+    RedPan,
+    GreenPan,
+    BluePan,
+    ConvolutionMix,
+    NumParameters
+};
+
+//==============================================================================
+/**
+ * Linear parameter smoothing engine built on juce::SmoothedValue
+ * 
+ * Audio thread usage per block: setTargets() when the snapshot changed, then
+ * process() once per rendered chunk, then read the ramps with getRamp().
+ */
+class ParameterSmoother
+{
+public:
+    // Ramp duration, kept well inside the 50 ms parameter response of SC-003
+    static constexpr double defaultRampSeconds = 0.02;
+    
+    ParameterSmoother() = default;
+    
+    /**
+     * Allocate ramp buffers and set the ramp duration (not real-time safe)
+     * @param sampleRate Processing sample rate
+     * @param maxBlockSize Largest chunk that will be passed to process()
+     * @param rampSeconds Duration of each ramp
+     */
+    void prepare(double sampleRate, int maxBlockSize, double rampSeconds = defaultRampSeconds);
+    
+    /**
+     * Change the rate ramps are processed at, keeping their duration (real-time safe)
+     * Ramps in progress carry on from their current value towards the same target.
+     * @param sampleRate Rate at which process() will be called per sample
+     */
+    void setSampleRate(double sampleRate);
+    
+    /**
+     * Jump straight to the snapshot values without ramping
+     * @param snapshot Parameter values to start from
+     */
+    void reset(const ParameterSnapshot& snapshot);
+    
+    /**
+     * Start ramping towards new snapshot values
+     * @param snapshot Target parameter values
+     */
+    void setTargets(const ParameterSnapshot& snapshot);
+    
+    /**
+     * Fill the ramp of every parameter for the next chunk
+     * @param numSamples Number of samples, at most the prepared block size
+     */
+    void process(int numSamples);
+    
+    /**
+     * Get the ramp filled by the last process() call
+     * @param parameter Parameter to read
+     * @return Array holding one value per processed sample
+     */
+    const float* getRamp(SmoothedParameter parameter) const;
+    
+    /**
+     * Check whether a parameter was still ramping during the last process() call
+     * @param parameter Parameter to check
+     * @return true if the ramp is not constant
+     */
+    bool isSmoothing(SmoothedParameter parameter) const;
+    
+    /**
+     * Get the value a parameter is ramping towards
+     * @param parameter Parameter to read
+     * @return Target value
+     */
+    float getTargetValue(SmoothedParameter parameter) const;
+    
+private:
+    static constexpr size_t numParameters = static_cast<size_t>(SmoothedParameter::NumParameters);
+    
+    static std::array<float, numParameters> getValues(const ParameterSnapshot& snapshot);
+    
+    std::array<juce::SmoothedValue<float>, numParameters> smoothers;
+    std::array<std::vector<float>, numParameters> ramps;
+    std::array<bool, numParameters> rampActive {};
+    int capacity {0};
+    double rampDuration {defaultRampSeconds};
+};
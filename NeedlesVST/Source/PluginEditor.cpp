@@ -30,11 +30,23 @@ NeedlesAudioProcessorEditor::NeedlesAudioProcessorEditor(NeedlesAudioProcessor&
     
     // Setup parameter controls
     setupParameterControls();
+    
+    // Background image load notifications (delivered on the message thread)
+    audioProcessor.onImageLoadProgress = [this](const juce::String& filePath, float progress)
+    {
+        handleImageLoadProgress(filePath, progress);
+    };
+    audioProcessor.onImageLoadComplete = [this](const ImageLoadStatus& status)
+    {
+        handleImageLoadComplete(status);
+    };
 }
 
 NeedlesAudioProcessorEditor::~NeedlesAudioProcessorEditor()
 {
-    // Cleanup will be added as components are implemented
+    // Stop receiving load notifications once the editor goes away
+    audioProcessor.onImageLoadProgress = nullptr;
+    audioProcessor.onImageLoadComplete = nullptr;
 }
 
 //==============================================================================
@@ -261,69 +273,65 @@ void NeedlesAudioProcessorEditor::loadImageFile()
         {
             juce::File imageFile = fc.getResult();
             
-            // Load the image
-            currentImage = juce::ImageFileFormat::loadFrom(imageFile);
+            // Decoding happens on the processor's loader thread; the UI stays
+            // responsive and is updated from the progress/completion callbacks
+            imageInfoLabel.setText("Loading " + imageFile.getFileName() + "...", juce::dontSendNotification);
+            imageInfoLabel.setColour(juce::Label::textColourId, juce::Colours::grey);
             
-            if (currentImage.isValid())
-            {
-                imageLoaded = true;
-                
-                // Update the display
-                imageDisplay.setImage(currentImage);
-                
-                // Load image into the audio processor using file path
-                bool loadSuccess = audioProcessor.loadImage(imageFile.getFullPathName());
-                
-                if (loadSuccess)
-                {
-                    // Update info label with successful load message
-                    auto fileSize = imageFile.getSize();
-                    juce::String sizeText;
-                    if (fileSize > 1024 * 1024)
-                        sizeText = juce::String(fileSize / (1024 * 1024)) + " MB";
-                    else if (fileSize > 1024)
-                        sizeText = juce::String(fileSize / 1024) + " KB";
-                    else
-                        sizeText = juce::String(fileSize) + " bytes";
-                        
-                    imageInfoLabel.setText("✓ " + imageFile.getFileName() + " (" + 
-                                          juce::String(currentImage.getWidth()) + "x" + 
-                                          juce::String(currentImage.getHeight()) + ", " + 
-                                          sizeText + ")", 
-                                          juce::dontSendNotification);
-                    imageInfoLabel.setColour(juce::Label::textColourId, juce::Colours::lightgreen);
-                }
-                else
-                {
-                    // Image loaded in UI but failed in audio processor - show detailed error
-                    juce::String errorMsg = audioProcessor.getLastError();
-                    if (errorMsg.isEmpty())
-                        errorMsg = "Unknown error during audio processing setup";
-                    
-                    imageInfoLabel.setText("⚠ " + errorMsg, juce::dontSendNotification);
-                    imageInfoLabel.setColour(juce::Label::textColourId, juce::Colours::orange);
-                    
-                    // Keep the image visible but audio won't start
-                }
-            }
-            else
-            {
-                // Failed to load image into UI
-                juce::String errorMsg = "Failed to load image file";
-                
-                // Try to load through processor to get detailed error message
-                audioProcessor.loadImage(imageFile.getFullPathName());
-                juce::String processorError = audioProcessor.getLastError();
-                if (processorError.isNotEmpty())
-                    errorMsg = processorError;
-                
-                imageInfoLabel.setText("✗ " + errorMsg, juce::dontSendNotification);
-                imageInfoLabel.setColour(juce::Label::textColourId, juce::Colours::red);
-            }
+            audioProcessor.loadImageAsync(imageFile.getFullPathName());
         }
     });
 }
 
+void NeedlesAudioProcessorEditor::handleImageLoadProgress(const juce::String& filePath, float progress)
+{
+    juce::File imageFile(filePath);
+    imageInfoLabel.setText("Loading " + imageFile.getFileName() + "... " +
+                           juce::String(juce::roundToInt(progress * 100.0f)) + "%",
+                           juce::dontSendNotification);
+}
+
+void NeedlesAudioProcessorEditor::handleImageLoadComplete(const ImageLoadStatus& status)
+{
+    juce::File imageFile(status.filePath);
+    
+    if (status.success)
+    {
+        currentImage = status.image;
+        imageLoaded = currentImage.isValid();
+        
+        // Update the display
+        updateImageDisplay();
+        
+        // Update info label with successful load message
+        auto fileSize = imageFile.getSize();
+        juce::String sizeText;
+        if (fileSize > 1024 * 1024)
+            sizeText = juce::String(fileSize / (1024 * 1024)) + " MB";
+        else if (fileSize > 1024)
+            sizeText = juce::String(fileSize / 1024) + " KB";
+        else
+            sizeText = juce::String(fileSize) + " bytes";
+            
+        imageInfoLabel.setText("✓ " + imageFile.getFileName() + " (" + 
+                              juce::String(status.dimensions.width) + "x" + 
+                              juce::String(status.dimensions.height) + ", " + 
+                              sizeText + ")", 
+                              juce::dontSendNotification);
+        imageInfoLabel.setColour(juce::Label::textColourId, juce::Colours::lightgreen);
+    }
+    else
+    {
+        // Show detailed error; the previously loaded image keeps playing
+        juce::String errorMsg = status.errorMessage;
+        if (errorMsg.isEmpty())
+            errorMsg = "Failed to load image file";
+        
+        imageInfoLabel.setText("✗ " + errorMsg, juce::dontSendNotification);
+        imageInfoLabel.setColour(juce::Label::textColourId, juce::Colours::red);
+    }
+}
+
 void NeedlesAudioProcessorEditor::updateImageDisplay()
 {
     if (imageLoaded && currentImage.isValid())
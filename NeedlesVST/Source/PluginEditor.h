@@ -85,6 +85,8 @@ private:
     // Image loading functionality
     void loadImageFile();
     void updateImageDisplay();
+    void handleImageLoadProgress(const juce::String& filePath, float progress);
+    void handleImageLoadComplete(const ImageLoadStatus& status);
     
     // Parameter setup
     void setupParameterControls();
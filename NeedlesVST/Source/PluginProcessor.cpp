@@ -1,5 +1,7 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "SpectrogramRenderer.h"
+#include "ImpulseResponseBuilder.h"
 
 //==============================================================================
 NeedlesAudioProcessor::NeedlesAudioProcessor()
@@ -14,19 +16,35 @@ NeedlesAudioProcessor::NeedlesAudioProcessor()
                          ),
 #endif
       parameters(*this, nullptr, juce::Identifier("NEEDLES"), createParameterLayout())
+    , imageLoadThread(imagePublisher)
 {
     // Initialize core components
-    imageLoader = createImageLoader();
-    imageScanner = createImageScanner();
     audioSynthesis = createAudioSynthesis();
     stereoProcessor = createStereoProcessor();
     
+    // Resolve parameter pointers once; processBlock only reads through them
+    parameterManager = createParameterManager();
+    parameterManager->bindParameters(parameters);
+    
+    // Background load notifications are delivered on the message thread
+    imageLoadThread.onProgress = [this](const juce::String& filePath, float progress)
+    {
+        handleImageLoadProgress(filePath, progress);
+    };
+    imageLoadThread.onComplete = [this](const ImageLoadStatus& status)
+    {
+        handleImageLoadComplete(status);
+    };
+    
+    // Latency changes flagged by the audio thread are reported from here
+    startTimer(latencyCheckIntervalMs);
+    
     DBG("Needles: AudioProcessor initialized with core components");
 }
 
 NeedlesAudioProcessor::~NeedlesAudioProcessor()
 {
-    // Destructor - cleanup will be added as components are implemented
+    stopTimer();
 }
 
 //==============================================================================
@@ -100,6 +118,38 @@ void NeedlesAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
     currentSampleRate = sampleRate;
     currentBlockSize = samplesPerBlock;
     
+    // Size the render scratch for the host's maximum block; anything larger is
+    // rendered in chunks by processBlock
+    renderScratch.allocate(juce::jmin(samplesPerBlock, maxRenderChunkSize));
+    
+    // Ramp buffers and needle phase tables match the render chunk size
+    parameterSmoother.prepare(sampleRate, renderScratch.capacity);
+    activeSmoothingRate = sampleRate;
+    needleBank.prepare(renderScratch.capacity);
+    
+    // Oversamplers for every factor, so quality switches never allocate
+    oversamplingBlockSize = juce::jmax(1, samplesPerBlock);
+    
+    for (size_t stage = 0; stage < numOversamplingStages; ++stage)
+    {
+        oversamplers[stage] = std::make_unique<juce::dsp::Oversampling<float>>(
+            2, stage + 1, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true, true);
+        oversamplers[stage]->initProcessing(static_cast<size_t>(oversamplingBlockSize));
+    }
+    
+    const auto* oversamplingParameter = parameters.getRawParameterValue("oversampling");
+    setOversampling(static_cast<OversamplingFactor>(juce::roundToInt(oversamplingParameter->load())));
+    latencyChanged = false;
+    setLatencySamples(pendingLatencySamples.load());
+    
+    // Convolution runs at the host rate over the same chunks as the needles
+    convolutionDry.setSize(2, renderScratch.capacity);
+    convolution.prepare({sampleRate, static_cast<juce::uint32>(renderScratch.capacity), 2});
+    convolution.reset();
+    
+    // Force derived parameter values to be rebuilt on the first block
+    derivedParametersValid = false;
+    
     // Audio processing initialization will be expanded in Phase 2
     isProcessingActive = true;
     
@@ -140,8 +190,6 @@ bool NeedlesAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) c
 
 void NeedlesAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
-    juce::ignoreUnused(midiMessages);
-    
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -150,282 +198,915 @@ void NeedlesAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
-    // Audio processing implementation skeleton - ready for user story implementations
-    // Thread-safe check for image loader and loaded state
-    juce::ScopedTryLock lock(imageMutex);
-    if (!lock.isLocked())
+    // Lock-free access to the current image; the snapshot stays valid until the
+    // end of this block even if a new image is published meanwhile
+    ImagePublisher::ReadScope imageScope(imagePublisher);
+    const auto* snapshot = imageScope.get();
+    
+    if (!isProcessingActive || snapshot == nullptr || renderScratch.capacity == 0)
     {
-        // Image is being loaded, output silence
         buffer.clear();
         return;
     }
     
-    auto* loader = imageLoader.get(); // Get raw pointer for null checking
-    if (!isProcessingActive || !loader || !loader->isLoaded())
+    auto* loader = snapshot->loader.get();
+    if (!loader || !loader->isLoaded())
+    {
+        buffer.clear();
+        return;
+    }
+
+    // Get image dimensions once for bounds checking
+    auto dims = snapshot->dimensions;
+    if (dims.width <= 0 || dims.height <= 0)
     {
         buffer.clear();
         return;
     }
+    
+    // A newly published image restarts every needle on its precompiled paths
+    if (snapshot->generation != activeImageGeneration)
+    {
+        needleBank.initialize(snapshot->scanPaths);
+        activeImageGeneration = snapshot->generation;
+        spectrogramActive = false;
+    }
 
-    // Get current parameters
-    auto* scanSpeedParam = parameters.getRawParameterValue("scanSpeed");
-    auto* areaSizeParam = parameters.getRawParameterValue("areaSize");
+    // One immutable parameter snapshot per block through the bound parameter pointers;
+    // derived values are only recomputed when something actually changed
+    parameterManager->updateFromValueTreeState(parameters);
+    const auto& params = parameterManager->getSnapshot();
+    
+    const bool parametersChanged = parameterManager->hasParametersChanged();
+    
+    // Quality switches only swap preallocated oversamplers
+    if (params.oversampling != activeOversampling)
+    {
+        setOversampling(params.oversampling);
+    }
     
-    float scanSpeed = scanSpeedParam ? scanSpeedParam->load() : 1.0f;
-    int areaSize = areaSizeParam ? static_cast<int>(areaSizeParam->load()) : 1;
+    // Smoothers step once per rendered sample: at the host rate while convolving,
+    // at the oversampled rate while rendering needles. Ramps keep their duration.
+    const double smoothingRate = params.synthesisMode == SynthesisMode::Convolution ? currentSampleRate
+                                                                                    : oversampledRate;
+    if (smoothingRate != activeSmoothingRate)
+    {
+        parameterSmoother.setSampleRate(smoothingRate);
+        activeSmoothingRate = smoothingRate;
+    }
     
-    // Additional safety check for valid area size
-    areaSize = juce::jlimit(1, 10, areaSize); // Limit area size to prevent performance issues
+    // Paths are precompiled in the snapshot, so switching patterns is just a pointer
+    // change; checked every block so a deferred path is picked up once built
+    needleBank.setScanPattern(params.scanPattern);
+    
+    if (!derivedParametersValid)
+    {
+        // First block after prepareToPlay starts from the current values without ramping
+        parameterSmoother.reset(params);
+        updateDerivedParameters(params);
+    }
+    else if (parametersChanged)
+    {
+        parameterSmoother.setTargets(params);
+        updateDerivedParameters(params);
+    }
     
-    // Generate audio samples
     auto numSamples = buffer.getNumSamples();
     auto numChannels = buffer.getNumChannels();
+    const bool midiTriggered = params.triggerMode == TriggerMode::Midi;
     
-    // Get image dimensions once for bounds checking
-    auto dims = loader->getDimensions();
-    if (dims.width <= 0 || dims.height <= 0)
+    // Leaving the spectrogram drops what it rendered ahead, so returning to it
+    // doesn't replay stale samples
+    const bool spectrogramMode = params.synthesisMode == SynthesisMode::Spectrogram;
+    
+    if (spectrogramActive && !spectrogramMode)
+    {
+        if (auto* spectrogram = loader->getSpectrogram())
+            spectrogram->flush();
+    }
+    
+    spectrogramActive = spectrogramMode;
+    
+    if (params.synthesisMode == SynthesisMode::Convolution)
+    {
+        // Voices are silent here but still follow the notes, so none hang when
+        // switching back to a scanning mode
+        if (midiTriggered)
+        {
+            for (const auto metadata : midiMessages)
+                handleMidiMessage(metadata.getMessage(), params);
+        }
+        
+        // The image filters the input instead of being scanned
+        processConvolution(buffer, *loader, params);
+        
+        for (int channel = 2; channel < numChannels; ++channel)
+        {
+            buffer.copyFrom(channel, 0, buffer, channel % 2, 0, numSamples);
+        }
+        
+        return;
+    }
+    
+    // A transport-locked scan is a pure function of the timeline position, so
+    // renders are repeatable and host seeks and loops cost nothing
+    float lockedScanRate = 0.0f;
+    const bool transportLocked = !midiTriggered
+                              && params.transportSync != TransportSync::FreeRunning
+                              && lockScanToTransport(params, lockedScanRate);
+    
+    if (transportLocked && lockedScanRate <= 0.0f)
     {
+        // Transport stopped (FR-013)
         buffer.clear();
         return;
     }
     
-    for (int sample = 0; sample < numSamples; ++sample)
+    if (midiTriggered)
     {
-        // Double-check loader is still valid (thread safety)
-        if (!loader || !loader->isLoaded())
+        // Split the block at every event so voices start and stop sample-accurately
+        int position = 0;
+        
+        for (const auto metadata : midiMessages)
         {
-            // Fill remaining samples with silence and return
-            for (int channel = 0; channel < numChannels; ++channel)
-            {
-                for (int s = sample; s < numSamples; ++s)
-                {
-                    buffer.setSample(channel, s, 0.0f);
-                }
-            }
-            return;
+            const int eventPosition = juce::jlimit(position, numSamples, metadata.samplePosition);
+            
+            renderRange(buffer, position, eventPosition - position, *loader, params, 0.0f);
+            handleMidiMessage(metadata.getMessage(), params);
+            position = eventPosition;
+        }
+        
+        renderRange(buffer, position, numSamples - position, *loader, params, 0.0f);
+    }
+    else
+    {
+        renderRange(buffer, 0, numSamples, *loader, params, lockedScanRate);
+    }
+    
+    // If more than 2 channels, duplicate stereo to remaining channels
+    for (int channel = 2; channel < numChannels; ++channel)
+    {
+        buffer.copyFrom(channel, 0, buffer, channel % 2, 0, numSamples);
+    }
+}
+
+void NeedlesAudioProcessor::renderRange(juce::AudioBuffer<float>& buffer, int startSample, int numSamples,
+                                        const IImageLoader& loader, const ParameterSnapshot& params,
+                                        float lockedScanRate)
+{
+    const int numChannels = buffer.getNumChannels();
+    
+    if (activeOversampler == nullptr)
+    {
+        renderNeedles(numChannels >= 1 ? buffer.getWritePointer(0, startSample) : nullptr,
+                      numChannels >= 2 ? buffer.getWritePointer(1, startSample) : nullptr,
+                      numSamples, loader, params, lockedScanRate, 1.0f);
+        return;
+    }
+    
+    const size_t numRenderedChannels = static_cast<size_t>(juce::jmin(2, numChannels));
+    const float rateScale = 1.0f / static_cast<float>(activeOversampler->getOversamplingFactor());
+    
+    // The needles are generators, so the upsampled input is only used as the
+    // oversampled render target and is overwritten
+    for (int offset = 0; offset < numSamples; offset += oversamplingBlockSize)
+    {
+        const int pieceSize = juce::jmin(oversamplingBlockSize, numSamples - offset);
+        juce::dsp::AudioBlock<float> block(buffer.getArrayOfWritePointers(), numRenderedChannels,
+                                           static_cast<size_t>(startSample + offset), static_cast<size_t>(pieceSize));
+        
+        auto oversampled = activeOversampler->processSamplesUp(block);
+        
+        renderNeedles(oversampled.getChannelPointer(0),
+                      numRenderedChannels > 1 ? oversampled.getChannelPointer(1) : nullptr,
+                      static_cast<int>(oversampled.getNumSamples()), loader, params, lockedScanRate, rateScale);
+        
+        activeOversampler->processSamplesDown(block);
+    }
+}
+
+void NeedlesAudioProcessor::renderNeedles(float* left, float* right, int numSamples, const IImageLoader& loader,
+                                          const ParameterSnapshot& params, float lockedScanRate, float rateScale)
+{
+    const bool voiceMode = needleBank.isVoiceMode();
+    
+    // Wavetable needles play an oscillator and only scan to select tables, so voices
+    // take their pitch from the oscillator and scan at the common speed
+    const bool wavetableMode = params.synthesisMode == SynthesisMode::WavetableRows
+                            || params.synthesisMode == SynthesisMode::WavetableColumns;
+    const WavetableBank* wavetables = wavetableMode
+        ? loader.getWavetables(params.synthesisMode == SynthesisMode::WavetableRows ? WavetableAxis::Rows
+                                                                                   : WavetableAxis::Columns)
+        : nullptr;
+    const double wavetableRate = params.wavetableFrequency / currentSampleRate * rateScale;
+    
+    // The spectrogram is rendered ahead at the rendering rate on the loader's worker,
+    // so its playhead runs freely even when the scan follows the transport
+    const bool spectrogramMode = params.synthesisMode == SynthesisMode::Spectrogram;
+    SpectrogramRenderer* spectrogram = spectrogramMode ? loader.getSpectrogram() : nullptr;
+    
+    if (spectrogram != nullptr)
+    {
+        spectrogram->setSettings({currentSampleRate / rateScale, params.spectrogramSpeed, params.conversionFormula});
+    }
+    
+    // Render in chunks no larger than the scratch buffers allocated in prepareToPlay
+    for (int chunkStart = 0; chunkStart < numSamples; chunkStart += renderScratch.capacity)
+    {
+        const int chunkSize = juce::jmin(renderScratch.capacity, numSamples - chunkStart);
+        
+        // Smoothed parameter ramps for this chunk
+        parameterSmoother.process(chunkSize);
+        
+        // All needles advance together; compiled paths never leave the image,
+        // so no per-sample bounds checks are needed. Voices run at their own rates.
+        if (voiceMode && !wavetableMode)
+        {
+            needleBank.advance(rateScale, chunkSize);
+        }
+        else if (lockedScanRate > 0.0f)
+        {
+            needleBank.advance(lockedScanRate * rateScale, chunkSize);
+        }
+        else
+        {
+            juce::FloatVectorOperations::multiply(renderScratch.scanRate.data(),
+                                                  parameterSmoother.getRamp(SmoothedParameter::ScanSpeed),
+                                                  rateScale, chunkSize);
+            needleBank.advance(renderScratch.scanRate.data(), chunkSize);
         }
         
-        // Advance scan position based on speed
-        Position currentPos = imageScanner->advancePosition(scanSpeed);
+        float* chunkLeft = left != nullptr ? left + chunkStart : nullptr;
+        float* chunkRight = right != nullptr ? right + chunkStart : nullptr;
         
-        // Bounds check the position before accessing image data
-        if (currentPos.x < 0.0f || currentPos.x >= static_cast<float>(dims.width) ||
-            currentPos.y < 0.0f || currentPos.y >= static_cast<float>(dims.height))
+        // Needles accumulate into the output, which is clamped once they are all mixed
+        for (auto* channel : { chunkLeft, chunkRight })
         {
-            // Reset scanner position if out of bounds
-            imageScanner->resetPosition();
-            currentPos = imageScanner->getCurrentPosition();
+            if (channel != nullptr)
+                juce::FloatVectorOperations::clear(channel, chunkSize);
         }
         
-        // Get RGB data from current position with additional safety
-        RGB pixelData{0, 0, 0};
-        try
+        // Area averages are constant time, so the full parameter range (1-50) is usable
+        if (!voiceMode)
         {
-            pixelData = loader->getAreaAverage(currentPos.x, currentPos.y, areaSize);
+            juce::FloatVectorOperations::clip(renderScratch.areaSize.data(),
+                                              parameterSmoother.getRamp(SmoothedParameter::AreaSize),
+                                              1.0f, 50.0f, chunkSize);
         }
-        catch (...)
+        
+        const bool panSmoothing = isPanSmoothing();
+        
+        if (panSmoothing)
         {
-            // If any exception occurs, use silence and continue
-            pixelData = RGB{0, 0, 0};
+            computePanGainRamps(chunkSize);
         }
         
-        // Convert RGB to separate channel audio samples
-        float redAudio = pixelData.toAudioChannel(0);    // Red channel
-        float greenAudio = pixelData.toAudioChannel(1);  // Green channel  
-        float blueAudio = pixelData.toAudioChannel(2);   // Blue channel
-        
-        // Get RGB pan parameter values
-        auto* redPanParam = parameters.getRawParameterValue("redPan");
-        auto* greenPanParam = parameters.getRawParameterValue("greenPan");
-        auto* bluePanParam = parameters.getRawParameterValue("bluePan");
-        
-        // Convert from percentage [-100, +100] to normalized [-1.0, +1.0]
-        float redPan = redPanParam ? redPanParam->load() / 100.0f : 0.0f;
-        float greenPan = greenPanParam ? greenPanParam->load() / 100.0f : 0.0f;
-        float bluePan = bluePanParam ? bluePanParam->load() / 100.0f : 0.0f;
-        
-        // Apply stereo positioning to individual RGB channels using StereoProcessor
-        auto [redLeft, redRight] = stereoProcessor->processPan(redAudio, redPan);
-        auto [greenLeft, greenRight] = stereoProcessor->processPan(greenAudio, greenPan);
-        auto [blueLeft, blueRight] = stereoProcessor->processPan(blueAudio, bluePan);
-        
-        // Mix processed RGB stereo channels to final output
-        float leftSample = (redLeft + greenLeft + blueLeft) / 3.0f;
-        float rightSample = (redRight + greenRight + blueRight) / 3.0f;
-        
-        // Clamp mixed samples to prevent clipping
-        leftSample = juce::jlimit(-1.0f, 1.0f, leftSample);
-        rightSample = juce::jlimit(-1.0f, 1.0f, rightSample);
-        
-        // Write stereo output (left channel = 0, right channel = 1)
-        if (numChannels >= 1)
-            buffer.setSample(0, sample, leftSample);   // Left channel
-        if (numChannels >= 2)
-            buffer.setSample(1, sample, rightSample);  // Right channel
-        
-        // If more than 2 channels, duplicate stereo to remaining channels
-        for (int channel = 2; channel < numChannels; ++channel)
+        if (spectrogramMode)
+        {
+            // The spectrogram replaces the needles; silent until an image is loaded
+            if (spectrogram != nullptr)
+                mixSpectrogram(*spectrogram, params, panSmoothing, chunkLeft, chunkRight, chunkSize);
+        }
+        else
+        {
+            const NeedleMixer mixer = selectNeedleMixer(params.conversionFormula, panSmoothing);
+            
+            for (int needle = 0; needle < needleBank.getNumNeedles(); ++needle)
+            {
+                needleBank.getPositions(needle, renderScratch.positionX.data(), renderScratch.positionY.data(), chunkSize);
+                
+                // A voice ramping in or out is mixed on its own first, then shaped by its envelope
+                const float* envelope = needleBank.getEnvelope(needle);
+                float* needleLeft = chunkLeft;
+                float* needleRight = chunkRight;
+                
+                if (envelope != nullptr)
+                {
+                    needleLeft = chunkLeft != nullptr ? renderScratch.voiceLeft.data() : nullptr;
+                    needleRight = chunkRight != nullptr ? renderScratch.voiceRight.data() : nullptr;
+                    
+                    for (auto* channel : { needleLeft, needleRight })
+                    {
+                        if (channel != nullptr)
+                            juce::FloatVectorOperations::clear(channel, chunkSize);
+                    }
+                }
+                
+                if (wavetableMode)
+                {
+                    // Silent until the background wavetable build has finished
+                    if (wavetables != nullptr)
+                    {
+                        const double cyclesPerSample = voiceMode ? needleBank.getVoiceRate(needle) * rateScale
+                                                                 : wavetableRate * needleBank.getSpeedScale(needle);
+                        mixWavetableNeedle(*wavetables, params, needle, cyclesPerSample, panSmoothing,
+                                           needleLeft, needleRight, chunkSize);
+                    }
+                }
+                else
+                {
+                    if (voiceMode)
+                        juce::FloatVectorOperations::fill(renderScratch.areaSize.data(), needleBank.getAreaSize(needle), chunkSize);
+                    
+                    (this->*mixer)(loader, params, needleBank.getGains(needle), needleLeft, needleRight, chunkSize);
+                }
+                
+                if (envelope != nullptr)
+                {
+                    if (chunkLeft != nullptr)
+                        juce::FloatVectorOperations::addWithMultiply(chunkLeft, needleLeft, envelope, chunkSize);
+                    
+                    if (chunkRight != nullptr)
+                        juce::FloatVectorOperations::addWithMultiply(chunkRight, needleRight, envelope, chunkSize);
+                }
+            }
+        }
+        
+        for (auto* channel : { chunkLeft, chunkRight })
         {
-            buffer.setSample(channel, sample, (channel % 2 == 0) ? leftSample : rightSample);
+            if (channel != nullptr)
+                juce::FloatVectorOperations::clip(channel, channel, -1.0f, 1.0f, chunkSize);
         }
     }
 }
 
-//==============================================================================
-bool NeedlesAudioProcessor::hasEditor() const
+void NeedlesAudioProcessor::handleMidiMessage(const juce::MidiMessage& message, const ParameterSnapshot& params)
 {
-    return true; // We want an editor
+    if (message.isNoteOn())
+    {
+        // One full path per cycle, so the path period follows the note frequency
+        const double frequency = juce::MidiMessage::getMidiNoteInHertz(message.getNoteNumber());
+        
+        // Velocity sets the voice level and sweeps the area from a single pixel up to
+        // the Area Size parameter
+        const float velocity = message.getFloatVelocity();
+        const float areaSize = juce::jmap(velocity, 1.0f, static_cast<float>(params.areaSize));
+        
+        needleBank.startVoice(message.getNoteNumber(), frequency / currentSampleRate, areaSize, velocity);
+    }
+    else if (message.isNoteOff())
+    {
+        needleBank.stopVoice(message.getNoteNumber());
+    }
+    else if (message.isAllNotesOff() || message.isAllSoundOff())
+    {
+        needleBank.stopAllVoices();
+    }
 }
 
-juce::AudioProcessorEditor* NeedlesAudioProcessor::createEditor()
+void NeedlesAudioProcessor::setOversampling(OversamplingFactor factor)
 {
-    return new NeedlesAudioProcessorEditor(*this);
+    const int stage = juce::jlimit(0, static_cast<int>(numOversamplingStages), static_cast<int>(factor));
+    
+    activeOversampling = factor;
+    activeOversampler = stage > 0 ? oversamplers[static_cast<size_t>(stage - 1)].get() : nullptr;
+    
+    if (activeOversampler != nullptr)
+    {
+        activeOversampler->reset();
+    }
+    
+    // Voice ramps keep their duration at the rendering rate; processBlock moves the
+    // parameter smoothers over
+    oversampledRate = currentSampleRate * static_cast<double>(1 << stage);
+    needleBank.setSampleRate(oversampledRate);
+    
+    // Reporting latency can block, so the timer passes it on to the host
+    pendingLatencySamples = activeOversampler != nullptr
+                          ? juce::roundToInt(activeOversampler->getLatencyInSamples())
+                          : 0;
+    latencyChanged = true;
+}
+
+void NeedlesAudioProcessor::timerCallback()
+{
+    if (latencyChanged.exchange(false))
+    {
+        setLatencySamples(pendingLatencySamples.load());
+    }
 }
 
 //==============================================================================
-void NeedlesAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
+void NeedlesAudioProcessor::updateDerivedParameters(const ParameterSnapshot& params)
 {
-    // State persistence implementation will be expanded in Phase 2
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    // Convert from percentage [-100, +100] to normalized [-1.0, +1.0] and compute
+    // the constant power gains of each RGB channel once per change
+    std::tie(derived.gains.redLeft, derived.gains.redRight) =
+        stereoProcessor->processPan(1.0f, params.redPan / 100.0f);
+    std::tie(derived.gains.greenLeft, derived.gains.greenRight) =
+        stereoProcessor->processPan(1.0f, params.greenPan / 100.0f);
+    std::tie(derived.gains.blueLeft, derived.gains.blueRight) =
+        stereoProcessor->processPan(1.0f, params.bluePan / 100.0f);
+    
+    const auto weights = getChannelWeights(params.conversionFormula);
+    derived.monoLeft = weights.red * derived.gains.redLeft + weights.green * derived.gains.greenLeft
+                     + weights.blue * derived.gains.blueLeft;
+    derived.monoRight = weights.red * derived.gains.redRight + weights.green * derived.gains.greenRight
+                      + weights.blue * derived.gains.blueRight;
+    
+    // Needle layout; only a change of count moves the needles. While MIDI triggers
+    // the needles the layout is ignored and the bank plays voices instead.
+    needleBank.setVoiceMode(params.triggerMode == TriggerMode::Midi);
+    needleBank.setPitchedScanning(params.synthesisMode == SynthesisMode::Scan);
+    needleBank.configure(params.numNeedles, params.needleDetune / 100.0f, params.needleSpread / 100.0f);
+    
+    derivedParametersValid = true;
 }
 
-void NeedlesAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
+//==============================================================================
+// Block render stages
+void NeedlesAudioProcessor::RenderScratch::allocate(int numSamples)
 {
-    // State restoration implementation will be expanded in Phase 2
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
+    capacity = juce::jmax(0, numSamples);
     
-    if (xmlState.get() != nullptr)
+    positionX.assign(static_cast<size_t>(capacity), 0.0f);
+    positionY.assign(static_cast<size_t>(capacity), 0.0f);
+    scanRate.assign(static_cast<size_t>(capacity), 0.0f);
+    areaSize.assign(static_cast<size_t>(capacity), 1.0f);
+    red.assign(static_cast<size_t>(capacity), 0);
+    green.assign(static_cast<size_t>(capacity), 0);
+    blue.assign(static_cast<size_t>(capacity), 0);
+    redAudio.assign(static_cast<size_t>(capacity), 0.0f);
+    greenAudio.assign(static_cast<size_t>(capacity), 0.0f);
+    blueAudio.assign(static_cast<size_t>(capacity), 0.0f);
+    monoAudio.assign(static_cast<size_t>(capacity), 0.0f);
+    voiceLeft.assign(static_cast<size_t>(capacity), 0.0f);
+    voiceRight.assign(static_cast<size_t>(capacity), 0.0f);
+    
+    for (auto* gain : { &redLeftGain, &redRightGain, &greenLeftGain,
+                        &greenRightGain, &blueLeftGain, &blueRightGain })
     {
-        if (xmlState->hasTagName(parameters.state.getType()))
-        {
-    parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
-        }
+        gain->assign(static_cast<size_t>(capacity), 0.0f);
     }
 }
 
-//==============================================================================
-// Image loading integration
-bool NeedlesAudioProcessor::loadImage(const juce::String& filePath)
+bool NeedlesAudioProcessor::lockScanToTransport(const ParameterSnapshot& params, float& scanRate)
 {
-    // Thread-safe image loading - prevent audio thread access during loading
-    juce::ScopedLock lock(imageMutex);
+    // Without a usable timeline the scan keeps running freely
+    auto* playHead = getPlayHead();
+    if (playHead == nullptr)
+        return false;
     
-    if (!imageLoader)
-    {
-        lastErrorMessage = "Image loader not initialized";
-        DBG("Needles: Error - " << lastErrorMessage);
+    const auto position = playHead->getPosition();
+    if (!position.hasValue())
         return false;
-    }
     
-    // Validate file path
-    if (filePath.isEmpty())
+    if (!position->getIsPlaying())
     {
-        lastErrorMessage = "Empty file path provided";
-        DBG("Needles: Error - " << lastErrorMessage);
-        return false;
+        scanRate = 0.0f;
+        return true;
     }
     
-    // Check if file exists
-    juce::File imageFile(filePath);
-    if (!imageFile.existsAsFile())
+    // The unsmoothed speed keeps the phase a function of the timeline alone
+    const double speed = static_cast<double>(params.scanSpeed);
+    const auto timeInSamples = position->getTimeInSamples();
+    
+    // Wavetable oscillators run at a fixed frequency, so they follow the timeline
+    // in samples whichever grid the scan follows
+    if (timeInSamples.hasValue())
     {
-        lastErrorMessage = "File does not exist: " + filePath;
-        DBG("Needles: Error - " << lastErrorMessage);
-        return false;
+        needleBank.setOscillatorPhases(static_cast<double>(*timeInSamples) * params.wavetableFrequency
+                                       / currentSampleRate);
     }
     
-    // Check file size (prevent loading extremely large files)
-    auto fileSize = imageFile.getSize();
-    const int64_t maxFileSize = 100 * 1024 * 1024; // 100MB limit
-    if (fileSize > maxFileSize)
+    if (params.transportSync == TransportSync::HostBeats)
     {
-        lastErrorMessage = "File too large: " + juce::String(fileSize / (1024 * 1024)) + "MB (max 100MB)";
-        DBG("Needles: Error - " << lastErrorMessage);
+        const auto ppq = position->getPpqPosition();
+        const auto bpm = position->getBpm();
+        
+        if (ppq.hasValue() && bpm.hasValue() && *bpm > 0.0)
+        {
+            // Scan speed is per sample at 120 BPM; the phase follows the beat grid
+            // through tempo changes
+            constexpr double referenceBpm = 120.0;
+            const double samplesPerReferenceBeat = currentSampleRate * 60.0 / referenceBpm;
+            
+            needleBank.setPhase(*ppq * samplesPerReferenceBeat * speed);
+            scanRate = static_cast<float>(speed * *bpm / referenceBpm);
+            return true;
+        }
+    }
+    
+    if (!timeInSamples.hasValue())
         return false;
+    
+    needleBank.setPhase(static_cast<double>(*timeInSamples) * speed);
+    scanRate = params.scanSpeed;
+    return true;
+}
+
+void NeedlesAudioProcessor::gatherPixelData(const IImageLoader& loader, BlurShape blurShape, int numSamples)
+{
+    // Positions and area sizes have been filled in the scratch buffers
+    loader.getAreaAverages(renderScratch.positionX.data(),
+                           renderScratch.positionY.data(),
+                           renderScratch.areaSize.data(),
+                           numSamples,
+                           renderScratch.red.data(),
+                           renderScratch.green.data(),
+                           renderScratch.blue.data(),
+                           blurShape);
+}
+
+void NeedlesAudioProcessor::convertPixelData(int numSamples)
+{
+    // Each colour channel becomes its own signal in one pass; output gain is
+    // applied later from the smoothed ramp
+    audioSynthesis->convertChannels(renderScratch.red.data(), renderScratch.green.data(), renderScratch.blue.data(),
+                                    renderScratch.redAudio.data(), renderScratch.greenAudio.data(),
+                                    renderScratch.blueAudio.data(), numSamples);
+}
+
+void NeedlesAudioProcessor::panAndMix(const RGBPanGains& gains, NeedleBank::Gains needleGains,
+                                      float* left, float* right, int numSamples)
+{
+    // Fold the needle gain into the pan gains; the stereo processor adds the 1/3
+    // mix normalisation, output gain and clamp in the same pass
+    RGBPanGains needlePanGains;
+    needlePanGains.redLeft = gains.redLeft * needleGains.left;
+    needlePanGains.greenLeft = gains.greenLeft * needleGains.left;
+    needlePanGains.blueLeft = gains.blueLeft * needleGains.left;
+    needlePanGains.redRight = gains.redRight * needleGains.right;
+    needlePanGains.greenRight = gains.greenRight * needleGains.right;
+    needlePanGains.blueRight = gains.blueRight * needleGains.right;
+    
+    stereoProcessor->processRGBBlock(renderScratch.redAudio.data(), renderScratch.greenAudio.data(),
+                                     renderScratch.blueAudio.data(), needlePanGains,
+                                     parameterSmoother.getRamp(SmoothedParameter::OutputGain),
+                                     left, right, numSamples);
+}
+
+void NeedlesAudioProcessor::convertMonoPixelData(ConversionFormula formula, int numSamples)
+{
+    // Formula, output gain and clamp in a single vectorised pass. A settled gain is
+    // folded into the conversion tables (rebuilt only when it changes), so the
+    // per-sample ramp is only read while the gain is moving.
+    const float* gainRamp = parameterSmoother.getRamp(SmoothedParameter::OutputGain);
+    
+    if (!parameterSmoother.isSmoothing(SmoothedParameter::OutputGain))
+    {
+        audioSynthesis->setGain(parameterSmoother.getTargetValue(SmoothedParameter::OutputGain));
+        gainRamp = nullptr;
     }
     
-    // Check file extension for supported formats
-    auto extension = imageFile.getFileExtension().toLowerCase();
-    juce::StringArray supportedFormats = { ".jpg", ".jpeg", ".png", ".gif", ".bmp" };
-    if (!supportedFormats.contains(extension))
+    audioSynthesis->convertBlock(renderScratch.red.data(),
+                                 renderScratch.green.data(),
+                                 renderScratch.blue.data(),
+                                 renderScratch.monoAudio.data(),
+                                 numSamples,
+                                 formula,
+                                 gainRamp);
+}
+
+template <bool panSmoothing>
+void NeedlesAudioProcessor::panMono(ConversionFormula formula, NeedleBank::Gains needleGains,
+                                    float* left, float* right, int numSamples)
+{
+    const float* mono = renderScratch.monoAudio.data();
+    
+    if constexpr (!panSmoothing)
     {
-        lastErrorMessage = "Unsupported file format: " + extension + 
-                          " (supported: " + supportedFormats.joinIntoString(", ") + ")";
-        DBG("Needles: Error - " << lastErrorMessage);
-        return false;
+        if (left != nullptr)
+            juce::FloatVectorOperations::addWithMultiply(left, mono, derived.monoLeft * needleGains.left, numSamples);
+        
+        if (right != nullptr)
+            juce::FloatVectorOperations::addWithMultiply(right, mono, derived.monoRight * needleGains.right, numSamples);
+        
+        return;
     }
     
-    // Attempt to load the image
-    LoadResult result = imageLoader->loadImage(filePath.toStdString());
+    // Gain ramps were filled by computePanGainRamps for this chunk
+    const auto weights = getChannelWeights(formula);
+    
+    auto pan = [=](float* out, float needleGain, const float* r, const float* g, const float* b)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            out[i] += mono[i] * needleGain * (weights.red * r[i] + weights.green * g[i] + weights.blue * b[i]);
+    };
+    
+    if (left != nullptr)
+        pan(left, needleGains.left,
+            renderScratch.redLeftGain.data(), renderScratch.greenLeftGain.data(), renderScratch.blueLeftGain.data());
+    
+    if (right != nullptr)
+        pan(right, needleGains.right,
+            renderScratch.redRightGain.data(), renderScratch.greenRightGain.data(), renderScratch.blueRightGain.data());
+}
+
+bool NeedlesAudioProcessor::isPanSmoothing() const
+{
+    return parameterSmoother.isSmoothing(SmoothedParameter::RedPan)
+        || parameterSmoother.isSmoothing(SmoothedParameter::GreenPan)
+        || parameterSmoother.isSmoothing(SmoothedParameter::BluePan);
+}
+
+void NeedlesAudioProcessor::computePanGainRamps(int numSamples)
+{
+    // Static pans use the exact gains in derived; ramps use the polynomial sin/cos law
+    auto fillGains = [this, numSamples](SmoothedParameter pan, float* left, float* right)
+    {
+        juce::FloatVectorOperations::multiply(left, parameterSmoother.getRamp(pan), 0.01f, numSamples);
+        stereoProcessor->computePanGains(left, left, right, numSamples);
+    };
+    
+    fillGains(SmoothedParameter::RedPan, renderScratch.redLeftGain.data(), renderScratch.redRightGain.data());
+    fillGains(SmoothedParameter::GreenPan, renderScratch.greenLeftGain.data(), renderScratch.greenRightGain.data());
+    fillGains(SmoothedParameter::BluePan, renderScratch.blueLeftGain.data(), renderScratch.blueRightGain.data());
+}
+
+void NeedlesAudioProcessor::panAndMixRamped(NeedleBank::Gains needleGains, float* left, float* right, int numSamples)
+{
+    // Gain ramps were filled by computePanGainRamps for this chunk
+    RGBPanGainRamps gains;
+    gains.redLeft = renderScratch.redLeftGain.data();
+    gains.redRight = renderScratch.redRightGain.data();
+    gains.greenLeft = renderScratch.greenLeftGain.data();
+    gains.greenRight = renderScratch.greenRightGain.data();
+    gains.blueLeft = renderScratch.blueLeftGain.data();
+    gains.blueRight = renderScratch.blueRightGain.data();
+    gains.leftScale = needleGains.left;
+    gains.rightScale = needleGains.right;
     
-    if (result.success)
+    stereoProcessor->processRGBBlock(renderScratch.redAudio.data(), renderScratch.greenAudio.data(),
+                                     renderScratch.blueAudio.data(), gains,
+                                     parameterSmoother.getRamp(SmoothedParameter::OutputGain),
+                                     left, right, numSamples);
+}
+
+template <bool separateChannels, bool panSmoothing>
+void NeedlesAudioProcessor::mixNeedle(const IImageLoader& loader, const ParameterSnapshot& params,
+                                      NeedleBank::Gains needleGains, float* left, float* right, int numSamples)
+{
+    if constexpr (separateChannels)
+    {
+        // The average keeps every colour channel separately panned
+        gatherPixelData(loader, params.blurShape, numSamples);
+        convertPixelData(numSamples);
+        
+        if constexpr (panSmoothing)
+            panAndMixRamped(needleGains, left, right, numSamples);
+        else
+            panAndMix(derived.gains, needleGains, left, right, numSamples);
+    }
+    else
     {
-        // Verify image dimensions are valid
-        auto dimensions = imageLoader->getDimensions();
-        if (dimensions.width <= 0 || dimensions.height <= 0)
+        // Cached formulas read finished samples; the rest convert gathered pixels
+        float* mono = renderScratch.monoAudio.data();
+        
+        if (loader.getAreaSamples(renderScratch.positionX.data(), renderScratch.positionY.data(),
+                                  renderScratch.areaSize.data(), numSamples, mono,
+                                  params.conversionFormula, params.blurShape))
         {
-            lastErrorMessage = "Invalid image dimensions: " + 
-                              juce::String(dimensions.width) + "x" + juce::String(dimensions.height);
-            DBG("Needles: Error - " << lastErrorMessage);
-            isProcessingActive = false;
-            return false;
+            juce::FloatVectorOperations::multiply(mono, parameterSmoother.getRamp(SmoothedParameter::OutputGain), numSamples);
+            juce::FloatVectorOperations::clip(mono, mono, -1.0f, 1.0f, numSamples);
         }
-        
-        // Check minimum image size
-        if (dimensions.width < 2 || dimensions.height < 2)
+        else
         {
-            lastErrorMessage = "Image too small for audio synthesis (minimum 2x2 pixels): " + 
-                              juce::String(dimensions.width) + "x" + juce::String(dimensions.height);
-            DBG("Needles: Error - " << lastErrorMessage);
-            isProcessingActive = false;
-            return false;
+            gatherPixelData(loader, params.blurShape, numSamples);
+            convertMonoPixelData(params.conversionFormula, numSamples);
         }
         
-        // Initialize scanner with image dimensions
-        imageScanner->initialize(dimensions.width, dimensions.height);
-        imageScanner->setLooping(true); // Enable infinite looping for US1
-        
-        // Clear any previous errors
-        lastErrorMessage.clear();
-        
-        // Audio will start automatically on next processBlock
-        isProcessingActive = true;
+        panMono<panSmoothing>(params.conversionFormula, needleGains, left, right, numSamples);
+    }
+}
+
+void NeedlesAudioProcessor::mixWavetableNeedle(const WavetableBank& wavetables, const ParameterSnapshot& params,
+                                               int needle, double cyclesPerSample, bool panSmoothing,
+                                               float* left, float* right, int numSamples)
+{
+    float* redAudio = renderScratch.redAudio.data();
+    float* greenAudio = renderScratch.greenAudio.data();
+    float* blueAudio = renderScratch.blueAudio.data();
+    
+    // Rows are selected by y and columns by x
+    const float* tablePositions = wavetables.getAxis() == WavetableAxis::Rows ? renderScratch.positionY.data()
+                                                                              : renderScratch.positionX.data();
+    
+    double phase = needleBank.getOscillatorPhase(needle);
+    wavetables.render(tablePositions, phase, cyclesPerSample, redAudio, greenAudio, blueAudio, numSamples);
+    needleBank.setOscillatorPhase(needle, phase);
+    
+    const NeedleBank::Gains needleGains = needleBank.getGains(needle);
+    
+    if (params.conversionFormula == ConversionFormula::RGBAverage)
+    {
+        if (panSmoothing)
+            panAndMixRamped(needleGains, left, right, numSamples);
+        else
+            panAndMix(derived.gains, needleGains, left, right, numSamples);
         
-        DBG("Needles: Image loaded successfully - " << filePath << " (" << dimensions.width << "x" << dimensions.height << ")");
-        return true;
+        return;
     }
+    
+    // The channels are already audio, and the byte-to-audio mapping is linear and
+    // increasing, so every formula applies to them directly
+    float* mono = renderScratch.monoAudio.data();
+    
+    switch (params.conversionFormula)
+    {
+        case ConversionFormula::MaxChannel:
+            juce::FloatVectorOperations::max(mono, redAudio, greenAudio, numSamples);
+            juce::FloatVectorOperations::max(mono, mono, blueAudio, numSamples);
+            break;
+            
+        case ConversionFormula::MinChannel:
+            juce::FloatVectorOperations::min(mono, redAudio, greenAudio, numSamples);
+            juce::FloatVectorOperations::min(mono, mono, blueAudio, numSamples);
+            break;
+            
+        default:
+        {
+            const auto weights = getChannelWeights(params.conversionFormula);
+            juce::FloatVectorOperations::copyWithMultiply(mono, redAudio, weights.red, numSamples);
+            juce::FloatVectorOperations::addWithMultiply(mono, greenAudio, weights.green, numSamples);
+            juce::FloatVectorOperations::addWithMultiply(mono, blueAudio, weights.blue, numSamples);
+            break;
+        }
+    }
+    
+    juce::FloatVectorOperations::multiply(mono, parameterSmoother.getRamp(SmoothedParameter::OutputGain), numSamples);
+    juce::FloatVectorOperations::clip(mono, mono, -1.0f, 1.0f, numSamples);
+    
+    if (panSmoothing)
+        panMono<true>(params.conversionFormula, needleGains, left, right, numSamples);
+    else
+        panMono<false>(params.conversionFormula, needleGains, left, right, numSamples);
+}
+
+void NeedlesAudioProcessor::mixSpectrogram(SpectrogramRenderer& spectrogram, const ParameterSnapshot& params,
+                                           bool panSmoothing, float* left, float* right, int numSamples)
+{
+    // Only copies from the worker's ring buffer; an underrun reads as silence
+    float* mono = renderScratch.monoAudio.data();
+    spectrogram.read(mono, numSamples);
+    
+    juce::FloatVectorOperations::multiply(mono, parameterSmoother.getRamp(SmoothedParameter::OutputGain), numSamples);
+    juce::FloatVectorOperations::clip(mono, mono, -1.0f, 1.0f, numSamples);
+    
+    if (panSmoothing)
+        panMono<true>(params.conversionFormula, {}, left, right, numSamples);
     else
+        panMono<false>(params.conversionFormula, {}, left, right, numSamples);
+}
+
+void NeedlesAudioProcessor::processConvolution(juce::AudioBuffer<float>& buffer, const IImageLoader& loader,
+                                               const ParameterSnapshot& params)
+{
+    // Only asks for a rebuild when a setting changed; silent until the first response arrives
+    if (auto* builder = loader.getImpulseResponseBuilder())
     {
-        // Handle various error types from ImageLoader
-        lastErrorMessage = "Failed to load image";
-        if (!result.errorMessage.empty())
+        builder->request({params.scanPattern, params.conversionFormula, static_cast<float>(params.areaSize),
+                          params.blurShape, juce::roundToInt(params.impulseLength * currentSampleRate)});
+        
+        if (builder->takeImpulseResponse(impulseResponse))
         {
-            lastErrorMessage += ": " + juce::String(result.errorMessage.c_str());
+            convolution.loadImpulseResponse(std::move(impulseResponse), currentSampleRate,
+                                            juce::dsp::Convolution::Stereo::no,
+                                            juce::dsp::Convolution::Trim::no,
+                                            juce::dsp::Convolution::Normalise::yes);
         }
+    }
+    
+    const int numChannels = juce::jmin(buffer.getNumChannels(), 2);
+    const int numSamples = buffer.getNumSamples();
+    juce::dsp::AudioBlock<float> block(buffer.getArrayOfWritePointers(), static_cast<size_t>(numChannels),
+                                       static_cast<size_t>(numSamples));
+    
+    for (int chunkStart = 0; chunkStart < numSamples; chunkStart += renderScratch.capacity)
+    {
+        const int chunkSize = juce::jmin(renderScratch.capacity, numSamples - chunkStart);
         
-        // Add user-friendly error interpretation
-        if (result.errorMessage.find("format") != std::string::npos || 
-            result.errorMessage.find("decode") != std::string::npos ||
-            result.errorMessage.find("invalid") != std::string::npos)
+        parameterSmoother.process(chunkSize);
+        
+        for (int channel = 0; channel < numChannels; ++channel)
         {
-            lastErrorMessage += " (The file may be corrupted or in an unsupported format)";
+            convolutionDry.copyFrom(channel, 0, buffer, channel, chunkStart, chunkSize);
         }
-        else if (result.errorMessage.find("memory") != std::string::npos)
+        
+        auto chunk = block.getSubBlock(static_cast<size_t>(chunkStart), static_cast<size_t>(chunkSize));
+        convolution.process(juce::dsp::ProcessContextReplacing<float>(chunk));
+        
+        const float* mix = parameterSmoother.getRamp(SmoothedParameter::ConvolutionMix);
+        const float* gain = parameterSmoother.getRamp(SmoothedParameter::OutputGain);
+        
+        // out = (dry + (wet - dry) * mix) * gain
+        for (int channel = 0; channel < numChannels; ++channel)
         {
-            lastErrorMessage += " (Insufficient memory to load image)";
+            float* wet = chunk.getChannelPointer(static_cast<size_t>(channel));
+            const float* dry = convolutionDry.getReadPointer(channel);
+            
+            juce::FloatVectorOperations::subtract(wet, dry, chunkSize);
+            juce::FloatVectorOperations::multiply(wet, mix, chunkSize);
+            juce::FloatVectorOperations::add(wet, dry, chunkSize);
+            juce::FloatVectorOperations::multiply(wet, gain, chunkSize);
+            juce::FloatVectorOperations::clip(wet, wet, -1.0f, 1.0f, chunkSize);
         }
-        else if (result.errorMessage.find("access") != std::string::npos ||
-                 result.errorMessage.find("permission") != std::string::npos)
+    }
+}
+
+NeedlesAudioProcessor::NeedleMixer NeedlesAudioProcessor::selectNeedleMixer(ConversionFormula formula, bool panSmoothing)
+{
+    static constexpr NeedleMixer mixers[2][2] = {
+        { &NeedlesAudioProcessor::mixNeedle<false, false>, &NeedlesAudioProcessor::mixNeedle<false, true> },
+        { &NeedlesAudioProcessor::mixNeedle<true, false>, &NeedlesAudioProcessor::mixNeedle<true, true> }
+    };
+    
+    const bool separateChannels = formula == ConversionFormula::RGBAverage;
+    return mixers[separateChannels ? 1 : 0][panSmoothing ? 1 : 0];
+}
+
+//==============================================================================
+bool NeedlesAudioProcessor::hasEditor() const
+{
+    return true; // We want an editor
+}
+
+juce::AudioProcessorEditor* NeedlesAudioProcessor::createEditor()
+{
+    return new NeedlesAudioProcessorEditor(*this);
+}
+
+//==============================================================================
+void NeedlesAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
+{
+    // State persistence implementation will be expanded in Phase 2
+    auto state = parameters.copyState();
+    std::unique_ptr<juce::XmlElement> xml(state.createXml());
+    copyXmlToBinary(*xml, destData);
+}
+
+void NeedlesAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
+{
+    // State restoration implementation will be expanded in Phase 2
+    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
+    
+    if (xmlState.get() != nullptr)
+    {
+        if (xmlState->hasTagName(parameters.state.getType()))
         {
-            lastErrorMessage += " (File access denied)";
+    parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
         }
-        
-        DBG("Needles: " << lastErrorMessage);
-        isProcessingActive = false;
+    }
+}
+
+//==============================================================================
+// Image loading integration
+bool NeedlesAudioProcessor::loadImage(const juce::String& filePath)
+{
+    // Synchronous load on the calling thread; editors should prefer loadImageAsync
+    auto snapshot = ImageLoadThread::buildSnapshot(filePath, {}, lastErrorMessage, getSampleCacheOptions());
+    
+    if (snapshot == nullptr)
+    {
         return false;
     }
+    
+    // Publish atomically; the scanner is re-initialized on the audio thread when
+    // it picks up the new snapshot, and the old one is freed in the background
+    imagePublisher.publish(std::move(snapshot));
+    
+    DBG("Needles: Image loaded successfully - " << filePath);
+    return true;
+}
+
+void NeedlesAudioProcessor::loadImageAsync(const juce::String& filePath)
+{
+    // Supersedes any load still in progress; results arrive via the callbacks below
+    imageLoadThread.setSampleCacheOptions(getSampleCacheOptions());
+    imageLoadThread.requestLoad(filePath);
+}
+
+void NeedlesAudioProcessor::setSampleCacheBudget(size_t budgetBytes)
+{
+    sampleCacheBudget = budgetBytes;
+}
+
+SampleCacheOptions NeedlesAudioProcessor::getSampleCacheOptions() const
+{
+    // Preload the formula that is playing now; the others are cached on first use.
+    // RGB average pans each channel separately and never reads the cache.
+    SampleCacheOptions options;
+    options.budgetBytes = sampleCacheBudget.load();
+    options.preloadFormula = parameterManager->getConversionFormula();
+    options.preload = options.preloadFormula != ConversionFormula::RGBAverage;
+    return options;
+}
+
+void NeedlesAudioProcessor::handleImageLoadProgress(const juce::String& filePath, float progress)
+{
+    if (onImageLoadProgress)
+        onImageLoadProgress(filePath, progress);
+}
+
+void NeedlesAudioProcessor::handleImageLoadComplete(const ImageLoadStatus& status)
+{
+    if (status.success)
+        lastErrorMessage.clear();
+    else
+        lastErrorMessage = status.errorMessage;
+    
+    if (onImageLoadComplete)
+        onImageLoadComplete(status);
 }
 
 //==============================================================================
@@ -500,9 +1181,89 @@ juce::AudioProcessorValueTreeState::ParameterLayout NeedlesAudioProcessor::creat
     params.push_back(std::make_unique<juce::AudioParameterChoice>(
         "scanPattern",
         "Scan Pattern", 
-        juce::StringArray{"Horizontal", "Vertical", "Diagonal", "Spiral"},
+        juce::StringArray{"Horizontal", "Vertical", "Diagonal", "Spiral", "Hilbert", "Z-Order"},
+        0));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "blurShape",
+        "Blur Shape",
+        juce::StringArray{"Box", "Gaussian", "Circular"},
+        0));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "transportSync",
+        "Transport Sync",
+        juce::StringArray{"Free Running", "Host Samples", "Host Beats"},
+        0));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "oversampling",
+        "Oversampling",
+        juce::StringArray{"Off", "2x", "4x", "8x"},
+        0));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "synthesisMode",
+        "Synthesis Mode",
+        juce::StringArray{"Scan", "Wavetable Rows", "Wavetable Columns", "Spectrogram", "Convolution"},
         0));
 
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "wavetableFrequency",
+        "Wavetable Frequency",
+        juce::NormalisableRange<float>(20.0f, 2000.0f, 0.01f, 0.3f),
+        110.0f,
+        "Hz"));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "spectrogramSpeed",
+        "Spectrogram Speed",
+        juce::NormalisableRange<float>(1.0f, 1000.0f, 0.01f, 0.3f),
+        40.0f,
+        "col/s"));
+
+    // Convolution mode: the input is convolved with the scan path read as an impulse response
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "impulseLength",
+        "Impulse Length",
+        juce::NormalisableRange<float>(0.05f, 6.0f, 0.001f, 0.5f),
+        1.5f,
+        "s"));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "convolutionMix",
+        "Convolution Mix",
+        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
+        100.0f,
+        "%"));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "triggerMode",
+        "Trigger Mode",
+        juce::StringArray{"Free Running", "MIDI"},
+        0));
+
+    // Polyphonic scanning: needles share the image and spread in phase, speed and pan
+    params.push_back(std::make_unique<juce::AudioParameterInt>(
+        "needleCount",
+        "Needle Count",
+        1, NeedleBank::maxNeedles,
+        1));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "needleDetune",
+        "Needle Detune",
+        juce::NormalisableRange<float>(0.0f, 50.0f, 0.1f),
+        0.0f,
+        "%"));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "needleSpread",
+        "Needle Spread",
+        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
+        0.0f,
+        "%"));
+
     return {params.begin(), params.end()};
 }
 
@@ -8,6 +8,7 @@
 #include <juce_audio_utils/juce_audio_utils.h>
 #include <juce_core/juce_core.h>
 #include <juce_data_structures/juce_data_structures.h>
+#include <juce_dsp/juce_dsp.h>
 #include <juce_events/juce_events.h>
 #include <juce_graphics/juce_graphics.h>
 #include <juce_gui_basics/juce_gui_basics.h>
@@ -15,11 +16,21 @@
 
 // Include core interfaces
 #include "ImageLoader.h"
-#include "ImageScanner.h"
+#include "ScanTypes.h"
 #include "AudioSynthesis.h"
 #include "ParameterManager.h"
 #include "PluginState.h"
 #include "StereoProcessor.h"
+#include "ImagePublisher.h"
+#include "ImageLoadThread.h"
+#include "ParameterSmoother.h"
+#include "NeedleBank.h"
+#include "WavetableBank.h"
+
+#include <array>
+#include <atomic>
+#include <tuple>
+#include <vector>
 
 //==============================================================================
 /**
@@ -35,6 +46,7 @@
  * - State persistence for DAW project compatibility
  */
 class NeedlesAudioProcessor : public juce::AudioProcessor
+                            , private juce::Timer
 {
 public:
     //==============================================================================
@@ -88,6 +100,18 @@ public:
     // Image loading integration (for editor to call)
     bool loadImage(const juce::String& filePath);
     
+    // Background image loading - returns immediately, a newer request supersedes
+    // an older one still in progress
+    void loadImageAsync(const juce::String& filePath);
+    
+    // Memory for cached per-formula sample tables, applied from the next load
+    static constexpr size_t defaultSampleCacheBudget = 128 * 1024 * 1024;
+    void setSampleCacheBudget(size_t budgetBytes);
+    
+    // Background load notifications for the editor, invoked on the message thread
+    std::function<void(const juce::String& filePath, float progress)> onImageLoadProgress;
+    std::function<void(const ImageLoadStatus& status)> onImageLoadComplete;
+    
     // Error handling - get last error message for UI display
     const juce::String& getLastError() const { return lastErrorMessage; }
     
@@ -101,8 +125,6 @@ private:
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
     // Core processing components - interfaces ready, implementations in user story phases
-    std::unique_ptr<IImageLoader> imageLoader;
-    std::unique_ptr<IImageScanner> imageScanner;
     std::unique_ptr<IAudioSynthesis> audioSynthesis;
     std::unique_ptr<IParameterManager> parameterManager;
     std::unique_ptr<IPluginState> pluginState;
@@ -113,8 +135,154 @@ private:
     int currentBlockSize {512};
     bool isProcessingActive {false};
     
-    // Thread safety
-    mutable juce::CriticalSection imageMutex;
+    //==============================================================================
+    // Block render pipeline
+    //
+    // processBlock renders in stages over whole chunks: all needles advance first,
+    // then for each needle pixel data is gathered into structure-of-arrays scratch
+    // buffers, and the conversion, panning and mixing passes run over contiguous
+    // arrays, accumulating into the output.
+    static constexpr int maxRenderChunkSize = 1024;
+    
+    struct RenderScratch
+    {
+        std::vector<float> positionX, positionY, areaSize;
+        std::vector<float> scanRate;  // Scan speed per rendered sample, scaled for oversampling
+        std::vector<uint8_t> red, green, blue;
+        std::vector<float> redAudio, greenAudio, blueAudio;
+        std::vector<float> monoAudio;  // Formula output for the non-average formulas
+        std::vector<float> voiceLeft, voiceRight;  // One voice's mix while its envelope ramps
+        
+        // Per-sample pan gains, only used while a pan parameter is ramping
+        std::vector<float> redLeftGain, redRightGain;
+        std::vector<float> greenLeftGain, greenRightGain;
+        std::vector<float> blueLeftGain, blueRightGain;
+        int capacity {0};
+        
+        void allocate(int numSamples);
+    };
+    
+    // Values derived from the parameter snapshot, rebuilt only when parameters change
+    struct DerivedParameters
+    {
+        RGBPanGains gains;  // Constant power pan gains for each RGB channel
+        
+        // Pan gains of the mono formula output, weighted by each channel's share in the formula
+        float monoLeft {0.0f}, monoRight {0.0f};
+    };
+    
+    RenderScratch renderScratch;
+    DerivedParameters derived;
+    bool derivedParametersValid {false};
+    ParameterSmoother parameterSmoother;
+    
+    // Scan heads over the shared image; one needle behaves like a single scanner
+    NeedleBank needleBank;
+    
+    void updateDerivedParameters(const ParameterSnapshot& params);
+    
+    // Renders [startSample, startSample + numSamples) of the buffer, oversampled if
+    // enabled; lockedScanRate is the transport-locked phase increment, or 0 to follow
+    // the smoothed scan speed
+    void renderRange(juce::AudioBuffer<float>& buffer, int startSample, int numSamples,
+                     const IImageLoader& loader, const ParameterSnapshot& params, float lockedScanRate);
+    
+    // Renders all needles at the current rendering rate; rateScale converts scan
+    // speeds from per-host-sample to per-rendered-sample
+    void renderNeedles(float* left, float* right, int numSamples, const IImageLoader& loader,
+                       const ParameterSnapshot& params, float lockedScanRate, float rateScale);
+    
+    // Starts and stops needle voices in MIDI trigger mode
+    void handleMidiMessage(const juce::MidiMessage& message, const ParameterSnapshot& params);
+    
+    // Sets the scan phase from the host playhead; false if there is no timeline to
+    // follow. scanRate is the phase increment per sample, 0 while stopped. Wavetable
+    // oscillators follow the timeline too; the spectrogram playhead does not.
+    bool lockScanToTransport(const ParameterSnapshot& params, float& scanRate);
+    
+    void gatherPixelData(const IImageLoader& loader, BlurShape blurShape, int numSamples);
+    void convertPixelData(int numSamples);
+    void panAndMix(const RGBPanGains& gains, NeedleBank::Gains needleGains, float* left, float* right, int numSamples);
+    void convertMonoPixelData(ConversionFormula formula, int numSamples);
+    
+    template <bool panSmoothing>
+    void panMono(ConversionFormula formula, NeedleBank::Gains needleGains, float* left, float* right, int numSamples);
+    
+    // Renders and mixes one needle at the positions in the scratch buffers.
+    // Instantiated for the per-channel average or a mono formula, with static or
+    // smoothed pans, and chosen once per chunk so the per-needle path has no
+    // formula or pan branches.
+    template <bool separateChannels, bool panSmoothing>
+    void mixNeedle(const IImageLoader& loader, const ParameterSnapshot& params,
+                   NeedleBank::Gains needleGains, float* left, float* right, int numSamples);
+    
+    using NeedleMixer = void (NeedlesAudioProcessor::*)(const IImageLoader&, const ParameterSnapshot&,
+                                                        NeedleBank::Gains, float*, float*, int);
+    static NeedleMixer selectNeedleMixer(ConversionFormula formula, bool panSmoothing);
+    
+    // Renders one needle's oscillator from the row or column wavetables and mixes it
+    // like a scanned needle; the needle's positions only select and morph the tables
+    void mixWavetableNeedle(const WavetableBank& wavetables, const ParameterSnapshot& params, int needle,
+                            double cyclesPerSample, bool panSmoothing, float* left, float* right, int numSamples);
+    
+    // Mixes the next spectrogram samples in place of the needles, panned like a
+    // mono needle
+    void mixSpectrogram(SpectrogramRenderer& spectrogram, const ParameterSnapshot& params,
+                        bool panSmoothing, float* left, float* right, int numSamples);
+    
+    bool isPanSmoothing() const;
+    void computePanGainRamps(int numSamples);
+    void panAndMixRamped(NeedleBank::Gains needleGains, float* left, float* right, int numSamples);
+    
+    //==============================================================================
+    // Oversampled rendering
+    //
+    // Needles are rendered at 2x, 4x or 8x and decimated by polyphase IIR half-band
+    // stages. One oversampler per factor is built in prepareToPlay, so switching
+    // quality on the audio thread only swaps the active one; the new latency is
+    // flagged and reported to the host from a message thread timer.
+    static constexpr size_t numOversamplingStages = 3;
+    std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, numOversamplingStages> oversamplers;
+    juce::dsp::Oversampling<float>* activeOversampler {nullptr};  // nullptr when off
+    OversamplingFactor activeOversampling {OversamplingFactor::Off};
+    int oversamplingBlockSize {0};  // Largest host-rate block passed to an oversampler
+    std::atomic<int> pendingLatencySamples {0};
+    std::atomic<bool> latencyChanged {false};
+    double oversampledRate {44100.0};       // Rate the needles are rendered at
+    double activeSmoothingRate {44100.0};   // Rate parameterSmoother is stepped at
+    
+    static constexpr int latencyCheckIntervalMs = 50;
+    
+    void setOversampling(OversamplingFactor factor);
+    void timerCallback() override;
+    
+    //==============================================================================
+    // Input convolution
+    //
+    // In convolution mode the input is convolved with the selected scan path read
+    // as an impulse response. Responses are built by the loader's worker and
+    // swapped in without allocating; the convolution loads them on its own
+    // background thread and crossfades from the previous response.
+    juce::dsp::Convolution convolution;  // Uniform partitions, no added latency
+    juce::AudioBuffer<float> impulseResponse;  // Swapped with the builder's finished response
+    juce::AudioBuffer<float> convolutionDry;  // Dry input of one render chunk
+    
+    void processConvolution(juce::AudioBuffer<float>& buffer, const IImageLoader& loader,
+                            const ParameterSnapshot& params);
+    
+    // Lock-free image hand-over between the message and audio threads
+    ImagePublisher imagePublisher;
+    uint64_t activeImageGeneration {0};  // Audio thread only
+    bool spectrogramActive {false};      // Spectrogram mode was playing last block; audio thread only
+    
+    // Decodes images off the message thread and publishes them via imagePublisher
+    ImageLoadThread imageLoadThread;
+    
+    std::atomic<size_t> sampleCacheBudget {defaultSampleCacheBudget};
+    SampleCacheOptions getSampleCacheOptions() const;
+    
+    void handleImageLoadProgress(const juce::String& filePath, float progress);
+    void handleImageLoadComplete(const ImageLoadStatus& status);
     
     // Error tracking
     juce::String lastErrorMessage;
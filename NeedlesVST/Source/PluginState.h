@@ -1,7 +1,7 @@
 #pragma once
 
 #include <juce_data_structures/juce_data_structures.h>
-#include "ImageScanner.h"
+#include "ScanTypes.h"
 #include "AudioSynthesis.h"
 #include <string>
 
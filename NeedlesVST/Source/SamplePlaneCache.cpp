@@ -0,0 +1,252 @@
+/*
+ * SamplePlaneCache.cpp - Sample table construction, recycling and lookup
+ */
+
+#include "SamplePlaneCache.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+//==============================================================================
+void SamplePlaneCache::prepare(const PixelPlanes& sourcePlanes, size_t budgetBytes)
+{
+    clear();
+
+    if (!sourcePlanes.isValid())
+    {
+        return;
+    }
+
+    planes = sourcePlanes;
+
+    const int tileSize = 1 << tileShift;
+    const int tilesPerColumn = (planes.height + tileSize) / tileSize;
+    tilesPerRow = (planes.width + tileSize) / tileSize;
+    tableSize = static_cast<size_t>(tilesPerRow) * static_cast<size_t>(tilesPerColumn)
+              * static_cast<size_t>(tileSize * tileSize);
+
+    // The cacheable (linear) formulas are the first five in ConversionFormula
+    const int numCacheable = static_cast<int>(ConversionFormula::BlueChannel) + 1;
+    numSlots = static_cast<int>(std::min(budgetBytes / getTableBytes(), static_cast<size_t>(numCacheable)));
+
+    if (numSlots == 0)
+    {
+        return;
+    }
+
+    slots = std::make_unique<Slot[]>(static_cast<size_t>(numSlots));
+
+    // Row 0, column 0 and the padding of partial tiles stay zero through every rebuild
+    for (int slot = 0; slot < numSlots; ++slot)
+    {
+        slots[static_cast<size_t>(slot)].table.assign(tableSize, 0u);
+    }
+}
+
+void SamplePlaneCache::clear()
+{
+    slots.reset();
+    numSlots = 0;
+    planes = PixelPlanes();
+    tilesPerRow = 0;
+    tableSize = 0;
+    requests = 0;
+}
+
+bool SamplePlaneCache::isCacheable(ConversionFormula formula)
+{
+    return formula == ConversionFormula::RGBAverage
+        || formula == ConversionFormula::WeightedRGB
+        || formula == ConversionFormula::RedChannel
+        || formula == ConversionFormula::GreenChannel
+        || formula == ConversionFormula::BlueChannel;
+}
+
+//==============================================================================
+size_t SamplePlaneCache::tableOffset(int x, int y) const
+{
+    const size_t tile = static_cast<size_t>(y >> tileShift) * static_cast<size_t>(tilesPerRow)
+                      + static_cast<size_t>(x >> tileShift);
+    const size_t withinTile = static_cast<size_t>(((y & tileMask) << tileShift) | (x & tileMask));
+
+    return (tile << (2 * tileShift)) | withinTile;
+}
+
+int SamplePlaneCache::findSlot(ConversionFormula formula) const
+{
+    for (int slot = 0; slot < numSlots; ++slot)
+    {
+        if (slots[static_cast<size_t>(slot)].formula.load() == static_cast<int>(formula))
+        {
+            return slot;
+        }
+    }
+
+    return -1;
+}
+
+bool SamplePlaneCache::contains(ConversionFormula formula) const
+{
+    return findSlot(formula) >= 0;
+}
+
+int SamplePlaneCache::chooseVictim() const
+{
+    int victim = 0;
+
+    for (int slot = 0; slot < numSlots; ++slot)
+    {
+        const Slot& candidate = slots[static_cast<size_t>(slot)];
+
+        if (candidate.formula.load() == emptySlot)
+        {
+            return slot;
+        }
+
+        if (candidate.lastUsed.load() < slots[static_cast<size_t>(victim)].lastUsed.load())
+        {
+            victim = slot;
+        }
+    }
+
+    return victim;
+}
+
+bool SamplePlaneCache::build(ConversionFormula formula, const std::function<bool()>& shouldCancel)
+{
+    if (numSlots == 0 || !isCacheable(formula))
+    {
+        return false;
+    }
+
+    if (contains(formula))
+    {
+        return true;
+    }
+
+    Slot& slot = slots[static_cast<size_t>(chooseVictim())];
+
+    // Unpublish the slot, then let readers that got in before that leave. A reader
+    // announces itself before re-checking the formula, so none can start reading
+    // the table once it has seen the slot empty.
+    slot.formula.store(emptySlot);
+
+    while (slot.readers.load() != 0)
+    {
+        std::this_thread::yield();
+    }
+
+    if (!fillTable(formula, slot.table, shouldCancel))
+    {
+        return false;
+    }
+
+    slot.lastUsed.store(useClock.fetch_add(1) + 1);
+    slot.formula.store(static_cast<int>(formula));
+    return true;
+}
+
+bool SamplePlaneCache::fillTable(ConversionFormula formula, std::vector<uint32_t>& table,
+                                 const std::function<bool()>& shouldCancel) const
+{
+    const ChannelWeights weights = getChannelWeights(formula);
+    const float fixedPointScale = static_cast<float>(1 << fixedPointShift);
+    const float weightRed = weights.red * fixedPointScale;
+    const float weightGreen = weights.green * fixedPointScale;
+    const float weightBlue = weights.blue * fixedPointScale;
+
+    for (int y = 0; y < planes.height; ++y)
+    {
+        if ((y & 63) == 0 && shouldCancel && shouldCancel())
+        {
+            return false;
+        }
+
+        const size_t planeOffset = planes.offsetOf(0, y);
+        const uint8_t* red = planes.red + planeOffset;
+        const uint8_t* green = planes.green + planeOffset;
+        const uint8_t* blue = planes.blue + planeOffset;
+
+        uint32_t rowSum = 0;
+
+        for (int x = 0; x < planes.width; ++x)
+        {
+            const float value = weightRed * red[x] + weightGreen * green[x] + weightBlue * blue[x];
+            rowSum += static_cast<uint32_t>(value + 0.5f);
+            table[tableOffset(x + 1, y + 1)] = table[tableOffset(x + 1, y)] + rowSum;
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+uint32_t SamplePlaneCache::takeRequests()
+{
+    return requests.exchange(0);
+}
+
+bool SamplePlaneCache::getAreaSamples(const float* x, const float* y, const float* areaSizes, int numPositions,
+                                      float* output, ConversionFormula formula) const
+{
+    const int index = findSlot(formula);
+
+    if (index < 0)
+    {
+        if (numSlots > 0 && isCacheable(formula))
+        {
+            requests.fetch_or(1u << static_cast<uint32_t>(formula));
+        }
+
+        return false;
+    }
+
+    Slot& slot = slots[static_cast<size_t>(index)];
+
+    // Announce the read, then confirm the slot wasn't recycled in between
+    slot.readers.fetch_add(1);
+
+    if (slot.formula.load() != static_cast<int>(formula))
+    {
+        slot.readers.fetch_sub(1);
+        requests.fetch_or(1u << static_cast<uint32_t>(formula));
+        return false;
+    }
+
+    const uint32_t* table = slot.table.data();
+    const float sampleScale = 2.0f / (255.0f * static_cast<float>(1 << fixedPointShift));
+
+    auto entry = [this, table](int column, int row)
+    {
+        return table[tableOffset(column, row)];
+    };
+
+    for (int i = 0; i < numPositions; ++i)
+    {
+        const int areaSize = std::min(maxWindowSize, std::max(1, static_cast<int>(areaSizes[i] + 0.5f)) | 1);
+        const int halfSize = areaSize / 2;
+        const int centerX = static_cast<int>(std::round(x[i]));
+        const int centerY = static_cast<int>(std::round(y[i]));
+
+        const int minX = std::max(0, centerX - halfSize);
+        const int maxX = std::min(planes.width - 1, centerX + halfSize);
+        const int minY = std::max(0, centerY - halfSize);
+        const int maxY = std::min(planes.height - 1, centerY + halfSize);
+
+        if (minX > maxX || minY > maxY)
+        {
+            output[i] = -1.0f;
+            continue;
+        }
+
+        const uint32_t sum = entry(maxX + 1, maxY + 1) - entry(minX, maxY + 1)
+                           - entry(maxX + 1, minY) + entry(minX, minY);
+        const float totalPixels = static_cast<float>((maxX - minX + 1) * (maxY - minY + 1));
+
+        output[i] = static_cast<float>(sum) * (sampleScale / totalPixels) - 1.0f;
+    }
+
+    slot.lastUsed.store(useClock.fetch_add(1) + 1);
+    slot.readers.fetch_sub(1);
+    return true;
+}
@@ -0,0 +1,137 @@
+/*
+ * SamplePlaneCache.h - Per-formula audio sample tables of a loaded image
+ *
+ * The mapping from pixels to samples is deterministic, so a linear conversion
+ * formula can be applied once per pixel at load time instead of once per
+ * sample. Each cached formula is kept as a summed-area table of its per-pixel
+ * values, so a box average of audio costs four loads for any window size.
+ * Tables live in a fixed number of slots sized from a memory budget, and the
+ * least recently used slot is recycled when another formula is needed.
+ */
+
+#pragma once
+
+#include "ImageLoader.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+ * Summed-area tables of converted samples, one per cached formula
+ *
+ * Per-pixel values are stored in 24.8 fixed point, so unsigned wrap-around
+ * keeps window sums exact for windows up to maxWindowSize pixels square.
+ * Entries are stored in the same 8 x 8 tiles as the loader's area table, so
+ * vertical and space-filling-curve scans stay within neighbouring cache lines.
+ *
+ * Threading: prepare() and build() run off the audio thread, one at a time.
+ * getAreaSamples() may run concurrently with build() on any number of reader
+ * threads and never blocks; a slot being recycled waits for its readers to
+ * leave before it is overwritten.
+ */
+class SamplePlaneCache
+{
+public:
+    static constexpr int fixedPointShift = 8;
+    static constexpr int maxWindowSize = 255;  // 255 * 255 * (255 << 8) < 2^32
+
+    SamplePlaneCache() = default;
+    ~SamplePlaneCache() = default;
+
+    /**
+     * Size the slots for an image, dropping any cached tables (not real-time safe)
+     * @param planes Source planes; must outlive the cache
+     * @param budgetBytes Memory for tables; less than one table disables the cache
+     */
+    void prepare(const PixelPlanes& planes, size_t budgetBytes);
+
+    /**
+     * Drop all tables and release their memory (not real-time safe)
+     */
+    void clear();
+
+    /**
+     * Cache a formula's table, recycling the least recently used slot if it
+     * isn't cached already (never call from the audio thread)
+     * @param formula Conversion formula, which must be cacheable
+     * @param shouldCancel Polled between rows; may be empty
+     * @return true if the formula is cached on return
+     */
+    bool build(ConversionFormula formula, const std::function<bool()>& shouldCancel = {});
+
+    /**
+     * Box-averaged samples at unity gain, in [-1.0, 1.0] (real-time safe)
+     * Windows follow IImageLoader::getAreaAverages, limited to maxWindowSize.
+     * A formula that isn't cached is queued for takeRequests() and false is
+     * returned without touching the output.
+     * @param x Array of center X coordinates
+     * @param y Array of center Y coordinates
+     * @param areaSizes Array of area sizes, rounded to the nearest odd pixel count
+     * @param numPositions Number of positions
+     * @param output Array receiving the samples
+     * @param formula Conversion formula
+     * @return true if the samples were written
+     */
+    bool getAreaSamples(const float* x, const float* y, const float* areaSizes, int numPositions,
+                        float* output, ConversionFormula formula) const;
+
+    /**
+     * Collect the formulas readers have asked for since the last call
+     * @return Mask with bit n set for the formula whose value is n
+     */
+    uint32_t takeRequests();
+
+    /**
+     * Check whether readers have asked for formulas not yet taken (real-time safe)
+     */
+    bool hasRequests() const { return requests.load() != 0; }
+
+    /**
+     * Check whether a formula has a finished table
+     * @param formula Conversion formula
+     * @return true if getAreaSamples() will succeed for it
+     */
+    bool contains(ConversionFormula formula) const;
+
+    /**
+     * Only linear formulas average the same before and after conversion
+     * @param formula Conversion formula
+     * @return true for formulas that can be cached
+     */
+    static bool isCacheable(ConversionFormula formula);
+
+    int getNumSlots() const { return numSlots; }
+    size_t getTableBytes() const { return tableSize * sizeof(uint32_t); }
+
+private:
+    //==============================================================================
+    static constexpr int emptySlot = -1;
+    static constexpr int tileShift = 3;
+    static constexpr int tileMask = (1 << tileShift) - 1;
+
+    struct Slot
+    {
+        std::vector<uint32_t> table;
+        std::atomic<int> formula {emptySlot};      // Cached formula, or emptySlot while unused or rebuilding
+        std::atomic<int> readers {0};              // Readers inside getAreaSamples()
+        std::atomic<uint64_t> lastUsed {0};        // useClock value of the last read
+    };
+
+    size_t tableOffset(int x, int y) const;
+    int findSlot(ConversionFormula formula) const;
+    int chooseVictim() const;
+    bool fillTable(ConversionFormula formula, std::vector<uint32_t>& table,
+                   const std::function<bool()>& shouldCancel) const;
+
+    PixelPlanes planes;
+    int tilesPerRow {0};                           // Tiles across (width + 1) entries
+    size_t tableSize {0};                          // (width + 1) x (height + 1) entries, rounded up to whole tiles
+    std::unique_ptr<Slot[]> slots;
+    int numSlots {0};
+
+    mutable std::atomic<uint32_t> requests {0};
+    mutable std::atomic<uint64_t> useClock {0};
+};
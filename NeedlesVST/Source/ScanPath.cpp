@@ -0,0 +1,737 @@
+/*
+ * ScanPath.cpp - Scan path compilation and arc-length lookup
+ */
+
+#include "ScanPath.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace
+{
+    constexpr double pi = 3.14159265358979323846;
+    constexpr double sqrtTwo = 1.41421356237309504880;
+    
+    // Arc length of the first count diagonals of a ramp whose k-th diagonal holds
+    // k + 1 pixels, each followed by a unit step to the next diagonal
+    double rampLength(double count)
+    {
+        return sqrtTwo * count * (count - 1.0) * 0.5 + count;
+    }
+    
+    // Number of whole ramp diagonals within a distance: the inverse of rampLength
+    double inverseRampLength(double arcLength)
+    {
+        const double linear = 1.0 - 0.5 * sqrtTwo;
+        return (std::sqrt(linear * linear + 2.0 * sqrtTwo * arcLength) - linear) / sqrtTwo;
+    }
+    
+    // Hilbert curve index to cell on a side x side grid (side a power of two)
+    void hilbertIndexToCell(uint64_t index, int side, int& x, int& y)
+    {
+        x = 0;
+        y = 0;
+        
+        for (int size = 1; size < side; size *= 2)
+        {
+            const int rx = static_cast<int>((index >> 1) & 1);
+            const int ry = static_cast<int>((index ^ static_cast<uint64_t>(rx)) & 1);
+            
+            // Rotate the quadrant so the sub-curves join end to end
+            if (ry == 0)
+            {
+                if (rx == 1)
+                {
+                    x = size - 1 - x;
+                    y = size - 1 - y;
+                }
+                
+                std::swap(x, y);
+            }
+            
+            x += size * rx;
+            y += size * ry;
+            index >>= 2;
+        }
+    }
+    
+    // Gathers the even bits of a Morton index into an integer
+    uint32_t compactEvenBits(uint64_t bits)
+    {
+        bits &= 0x5555555555555555ull;
+        bits = (bits | (bits >> 1)) & 0x3333333333333333ull;
+        bits = (bits | (bits >> 2)) & 0x0f0f0f0f0f0f0f0full;
+        bits = (bits | (bits >> 4)) & 0x00ff00ff00ff00ffull;
+        bits = (bits | (bits >> 8)) & 0x0000ffff0000ffffull;
+        bits = (bits | (bits >> 16)) & 0x00000000ffffffffull;
+        return static_cast<uint32_t>(bits);
+    }
+}
+
+//==============================================================================
+void ScanPath::compile(ScanPattern patternToCompile, Dimensions imageDimensions)
+{
+    pattern = patternToCompile;
+    dimensions = imageDimensions;
+    segments.clear();
+    lookup.clear();
+    totalLength = 0.0;
+    lookupScale = 0.0;
+    kind = Kind::Segments;
+    curvePoints.clear();
+    curvePoints.shrink_to_fit();
+    
+    if (!dimensions.isValid())
+    {
+        return;
+    }
+    
+    switch (pattern)
+    {
+        case ScanPattern::Vertical:
+            addSerpentineColumns();
+            break;
+            
+        case ScanPattern::Diagonal:
+            compileDiagonal();
+            return;
+            
+        case ScanPattern::Spiral:
+            compileSpiral();
+            return;
+            
+        case ScanPattern::Hilbert:
+            compileCurve();
+            return;
+            
+        case ScanPattern::Morton:
+            compileMorton();
+            return;
+            
+        case ScanPattern::Horizontal:
+        default:
+            addSerpentineRows();
+            break;
+    }
+    
+    buildLookup();
+}
+
+void ScanPath::addSegment(Position from, Position to, double arcLength)
+{
+    Segment segment;
+    segment.startX = from.x;
+    segment.startY = from.y;
+    segment.deltaX = to.x - from.x;
+    segment.deltaY = to.y - from.y;
+    segment.startArc = totalLength;
+    segment.inverseLength = 1.0 / arcLength;
+    
+    segments.push_back(segment);
+    totalLength += arcLength;
+}
+
+void ScanPath::addSerpentineRows()
+{
+    // Left-to-right, then right-to-left on the next row. A single-pixel-wide
+    // image still spends one pixel of travel per row.
+    const float lastX = static_cast<float>(dimensions.width - 1);
+    const double rowLength = std::max(1.0, static_cast<double>(dimensions.width - 1));
+    
+    segments.reserve(static_cast<size_t>(dimensions.height));
+    
+    for (int row = 0; row < dimensions.height; ++row)
+    {
+        const float y = static_cast<float>(row);
+        const bool rightToLeft = (row % 2) != 0;
+        
+        addSegment(Position(rightToLeft ? lastX : 0.0f, y),
+                   Position(rightToLeft ? 0.0f : lastX, y),
+                   rowLength);
+    }
+}
+
+void ScanPath::addSerpentineColumns()
+{
+    // Top-to-bottom, then bottom-to-top on the next column
+    const float lastY = static_cast<float>(dimensions.height - 1);
+    const double columnLength = std::max(1.0, static_cast<double>(dimensions.height - 1));
+    
+    segments.reserve(static_cast<size_t>(dimensions.width));
+    
+    for (int column = 0; column < dimensions.width; ++column)
+    {
+        const float x = static_cast<float>(column);
+        const bool bottomToTop = (column % 2) != 0;
+        
+        addSegment(Position(x, bottomToTop ? lastY : 0.0f),
+                   Position(x, bottomToTop ? 0.0f : lastY),
+                   columnLength);
+    }
+}
+
+void ScanPath::compileDiagonal()
+{
+    kind = Kind::Diagonal;
+    shortSide = std::min(dimensions.width, dimensions.height);
+    longSide = std::max(dimensions.width, dimensions.height);
+    numDiagonals = dimensions.width + dimensions.height - 1;
+    
+    // The last diagonal is the single bottom-right pixel
+    totalLength = getDiagonalStart(numDiagonals - 1);
+}
+
+double ScanPath::getDiagonalStart(int diagonal) const
+{
+    // Diagonals grow by a pixel up to the short side, hold that length across the
+    // long side, then shrink. Each costs sqrt(2) per step between its pixels plus
+    // the unit step to the next one.
+    const int rising = std::min(diagonal, shortSide - 1);
+    const int level = std::clamp(diagonal - (shortSide - 1), 0, longSide - shortSide + 1);
+    const int falling = std::max(0, diagonal - longSide);
+    
+    const double levelLength = sqrtTwo * static_cast<double>(shortSide - 1) + 1.0;
+    
+    return rampLength(static_cast<double>(rising))
+         + levelLength * static_cast<double>(level)
+         + (levelLength - sqrtTwo) * static_cast<double>(falling)
+         - sqrtTwo * static_cast<double>(falling) * static_cast<double>(falling - 1) * 0.5;
+}
+
+int ScanPath::findDiagonal(double arcLength) const
+{
+    const double levelStart = getDiagonalStart(shortSide - 1);
+    const double fallingStart = getDiagonalStart(longSide);
+    double estimate;
+    
+    if (arcLength < levelStart)
+    {
+        estimate = inverseRampLength(arcLength);
+    }
+    else if (arcLength < fallingStart)
+    {
+        const double levelLength = sqrtTwo * static_cast<double>(shortSide - 1) + 1.0;
+        estimate = static_cast<double>(shortSide - 1) + (arcLength - levelStart) / levelLength;
+    }
+    else
+    {
+        // The falling ramp mirrors the rising one, counted back from the end
+        estimate = static_cast<double>(numDiagonals - 1) - inverseRampLength(totalLength - arcLength);
+    }
+    
+    int diagonal = std::clamp(static_cast<int>(estimate), 0, numDiagonals - 1);
+    
+    // The estimate is within one diagonal; settle rounding at the boundaries
+    while (diagonal > 0 && getDiagonalStart(diagonal) > arcLength)
+    {
+        --diagonal;
+    }
+    
+    while (diagonal + 1 < numDiagonals && getDiagonalStart(diagonal + 1) <= arcLength)
+    {
+        ++diagonal;
+    }
+    
+    return diagonal;
+}
+
+Position ScanPath::getDiagonalStartPixel(int diagonal) const
+{
+    // Even diagonals run up and to the right, odd ones down and to the left
+    const int x = (diagonal % 2) == 0 ? std::max(0, diagonal - (dimensions.height - 1))
+                                      : std::min(diagonal, dimensions.width - 1);
+    
+    return Position(static_cast<float>(x), static_cast<float>(diagonal - x));
+}
+
+Position ScanPath::evaluateDiagonal(double arcLength) const
+{
+    const int diagonal = findDiagonal(arcLength);
+    const Position start = getDiagonalStartPixel(diagonal);
+    const float direction = (diagonal % 2) == 0 ? 1.0f : -1.0f;
+    
+    const int numPixels = std::min({diagonal + 1, shortSide, numDiagonals - diagonal});
+    const double pixelRun = sqrtTwo * static_cast<double>(numPixels - 1);
+    const double along = arcLength - getDiagonalStart(diagonal);
+    
+    if (along <= pixelRun || diagonal + 1 >= numDiagonals)
+    {
+        const float steps = static_cast<float>(std::min(along, pixelRun) / sqrtTwo);
+        return Position(start.x + direction * steps, start.y - direction * steps);
+    }
+    
+    // Unit step along the image edge to the start of the next diagonal
+    const float run = static_cast<float>(numPixels - 1);
+    const Position end(start.x + direction * run, start.y - direction * run);
+    const Position next = getDiagonalStartPixel(diagonal + 1);
+    const float t = static_cast<float>(along - pixelRun);
+    
+    return Position(end.x + (next.x - end.x) * t, end.y + (next.y - end.y) * t);
+}
+
+void ScanPath::compileSpiral()
+{
+    kind = Kind::Spiral;
+    centreX = 0.5 * static_cast<double>(dimensions.width - 1);
+    centreY = 0.5 * static_cast<double>(dimensions.height - 1);
+    radiusX = centreX;
+    radiusY = centreY;
+    
+    // One pixel between turns along the longer axis
+    spiralTurns = std::max(1.0, std::max(radiusX, radiusY));
+    
+    // For r = R * theta / (2 pi N) with R = N, s(theta) = theta^2 / (4 pi),
+    // so the full spiral (theta = 2 pi N) is pi N^2 long
+    totalLength = pi * spiralTurns * spiralTurns;
+}
+
+void ScanPath::compileCurve()
+{
+    kind = Kind::Curve;
+    
+    const int width = dimensions.width;
+    const int height = dimensions.height;
+    
+    const int side = getCurveSide();
+    int order = 0;
+    
+    while ((1 << order) < side)
+    {
+        ++order;
+    }
+    
+    const uint64_t numCells = static_cast<uint64_t>(side) * static_cast<uint64_t>(side);
+    curvePoints.reserve(static_cast<size_t>(width) * static_cast<size_t>(height));
+    
+    uint64_t index = 0;
+    
+    while (index < numCells)
+    {
+        int x, y;
+        hilbertIndexToCell(index, side, x, y);
+        
+        if (x < width && y < height)
+        {
+            curvePoints.push_back(static_cast<uint32_t>(x) | (static_cast<uint32_t>(y) << 16));
+            ++index;
+            continue;
+        }
+        
+        // The curve fills aligned 2^k squares with runs of 4^k indices, so skip
+        // the largest run starting here whose square lies wholly outside the image
+        int level = 0;
+        
+        while (level < order && (index & ((uint64_t(4) << (2 * level)) - 1)) == 0)
+        {
+            const int blockMask = ~((2 << level) - 1);
+            
+            if ((x & blockMask) < width && (y & blockMask) < height)
+                break;
+            
+            ++level;
+        }
+        
+        index += uint64_t(1) << (2 * level);
+    }
+    
+    // One unit of arc length per pixel
+    totalLength = static_cast<double>(curvePoints.size());
+}
+
+int ScanPath::getCurveSide() const
+{
+    int side = 1;
+    
+    while (side < std::max(dimensions.width, dimensions.height))
+    {
+        side *= 2;
+    }
+    
+    return side;
+}
+
+void ScanPath::compileMorton()
+{
+    kind = Kind::Morton;
+    curveSide = getCurveSide();
+    
+    // One unit of arc length per pixel
+    totalLength = static_cast<double>(dimensions.width) * static_cast<double>(dimensions.height);
+}
+
+Position ScanPath::getMortonCell(uint64_t visit) const
+{
+    int x = 0;
+    int y = 0;
+    int size = curveSide;
+    
+    // Descend through the squares clipped by the image edge, counting the pixels
+    // each quadrant holds, until the visit falls in a square wholly inside
+    while (size > 1 && (x + size > dimensions.width || y + size > dimensions.height))
+    {
+        size /= 2;
+        
+        // Z order: (0, 0), (1, 0), (0, 1), (1, 1)
+        for (int quadrant = 0; quadrant < 4; ++quadrant)
+        {
+            const int quadrantX = x + (quadrant & 1) * size;
+            const int quadrantY = y + (quadrant >> 1) * size;
+            const uint64_t numPixels = static_cast<uint64_t>(std::clamp(dimensions.width - quadrantX, 0, size))
+                                     * static_cast<uint64_t>(std::clamp(dimensions.height - quadrantY, 0, size));
+            
+            if (visit < numPixels || quadrant == 3)
+            {
+                x = quadrantX;
+                y = quadrantY;
+                break;
+            }
+            
+            visit -= numPixels;
+        }
+    }
+    
+    // Inside a whole square the visit is the Morton index itself: even bits are
+    // x, odd bits are y
+    return Position(static_cast<float>(x + static_cast<int>(compactEvenBits(visit))),
+                    static_cast<float>(y + static_cast<int>(compactEvenBits(visit >> 1))));
+}
+
+Position ScanPath::evaluateMorton(double arcLength) const
+{
+    const uint64_t last = static_cast<uint64_t>(totalLength) - 1;
+    const uint64_t index = std::min(static_cast<uint64_t>(arcLength), last);
+    Position position = getMortonCell(index);
+    
+    if (index < last)
+    {
+        const Position next = getMortonCell(index + 1);
+        const float deltaX = next.x - position.x;
+        const float deltaY = next.y - position.y;
+        
+        // Glide to a neighbouring pixel; jump anywhere else
+        if (std::abs(deltaX) + std::abs(deltaY) == 1.0f)
+        {
+            const float t = static_cast<float>(arcLength - static_cast<double>(index));
+            position.x += deltaX * t;
+            position.y += deltaY * t;
+        }
+    }
+    
+    return position;
+}
+
+Position ScanPath::evaluateCurve(double arcLength) const
+{
+    const size_t last = curvePoints.size() - 1;
+    const size_t index = std::min(static_cast<size_t>(arcLength), last);
+    const uint32_t point = curvePoints[index];
+    
+    float x = static_cast<float>(point & 0xffff);
+    float y = static_cast<float>(point >> 16);
+    
+    if (index < last)
+    {
+        const uint32_t next = curvePoints[index + 1];
+        const float deltaX = static_cast<float>(next & 0xffff) - x;
+        const float deltaY = static_cast<float>(next >> 16) - y;
+        
+        // Glide to a neighbouring pixel; jump anywhere else
+        if (std::abs(deltaX) + std::abs(deltaY) == 1.0f)
+        {
+            const float t = static_cast<float>(arcLength - static_cast<double>(index));
+            x += deltaX * t;
+            y += deltaY * t;
+        }
+    }
+    
+    return Position(x, y);
+}
+
+template <ScanPath::Kind pathKind>
+Position ScanPath::evaluate(double arcLength) const
+{
+    static_assert(pathKind != Kind::Segments, "Segments are located through the lookup, not evaluated");
+    
+    if constexpr (pathKind == Kind::Curve)
+    {
+        return evaluateCurve(arcLength);
+    }
+    else if constexpr (pathKind == Kind::Morton)
+    {
+        return evaluateMorton(arcLength);
+    }
+    else if constexpr (pathKind == Kind::Diagonal)
+    {
+        return evaluateDiagonal(arcLength);
+    }
+    else
+    {
+        // Spiral: invert s(theta) = theta^2 / (4 pi)
+        const double theta = std::sqrt(4.0 * pi * arcLength);
+        const double radius = theta / (2.0 * pi * spiralTurns);
+        
+        return Position(static_cast<float>(centreX + radiusX * radius * std::cos(theta)),
+                        static_cast<float>(centreY + radiusY * radius * std::sin(theta)));
+    }
+}
+
+template <ScanPath::Kind pathKind>
+void ScanPath::evaluateBlock(const double* arcLengths, float* x, float* y, int numPositions) const
+{
+    // One instantiation per kind, so the loop carries no per-sample dispatch
+    for (int i = 0; i < numPositions; ++i)
+    {
+        const Position position = evaluate<pathKind>(arcLengths[i]);
+        x[i] = position.x;
+        y[i] = position.y;
+    }
+}
+
+Position ScanPath::evaluateClosedForm(double arcLength) const
+{
+    switch (kind)
+    {
+        case Kind::Curve:     return evaluate<Kind::Curve>(arcLength);
+        case Kind::Morton:    return evaluate<Kind::Morton>(arcLength);
+        case Kind::Diagonal:  return evaluate<Kind::Diagonal>(arcLength);
+        case Kind::Spiral:
+        case Kind::Segments:
+        default:              return evaluate<Kind::Spiral>(arcLength);
+    }
+}
+
+void ScanPath::buildLookup()
+{
+    if (segments.empty() || totalLength <= 0.0)
+    {
+        return;
+    }
+    
+    // Twice as many buckets as segments keeps the search to a step or two
+    const size_t numBuckets = segments.size() * 2;
+    lookup.resize(numBuckets);
+    lookupScale = static_cast<double>(numBuckets) / totalLength;
+    
+    size_t segment = 0;
+    
+    for (size_t bucket = 0; bucket < numBuckets; ++bucket)
+    {
+        const double bucketStart = static_cast<double>(bucket) / lookupScale;
+        
+        while (segment + 1 < segments.size() && segments[segment + 1].startArc <= bucketStart)
+        {
+            ++segment;
+        }
+        
+        lookup[bucket] = static_cast<int>(segment);
+    }
+}
+
+//==============================================================================
+int ScanPath::findSegment(double arcLength) const
+{
+    const int numSegments = static_cast<int>(segments.size());
+    const int bucket = std::clamp(static_cast<int>(arcLength * lookupScale), 0, static_cast<int>(lookup.size()) - 1);
+    
+    int segment = lookup[static_cast<size_t>(bucket)];
+    
+    while (segment + 1 < numSegments && segments[static_cast<size_t>(segment + 1)].startArc <= arcLength)
+    {
+        ++segment;
+    }
+    
+    return segment;
+}
+
+double ScanPath::getSegmentEnd(int index) const
+{
+    return index + 1 < static_cast<int>(segments.size()) ? segments[static_cast<size_t>(index + 1)].startArc
+                                                         : totalLength;
+}
+
+int ScanPath::locateSegment(double arcLength, int segmentHint) const
+{
+    const int numSegments = static_cast<int>(segments.size());
+    
+    auto contains = [&](int index)
+    {
+        if (index < 0 || index >= numSegments)
+            return false;
+        
+        return segments[static_cast<size_t>(index)].startArc <= arcLength
+            && (arcLength < getSegmentEnd(index) || index == numSegments - 1);
+    };
+    
+    // Sequential scans stay in the hinted segment or move to the next one
+    if (contains(segmentHint))
+        return segmentHint;
+    
+    if (contains(segmentHint + 1))
+        return segmentHint + 1;
+    
+    return findSegment(arcLength);
+}
+
+Position ScanPath::getPositionAt(double arcLength, int& segmentHint) const
+{
+    if (isEmpty())
+    {
+        return Position(0.0f, 0.0f);
+    }
+    
+    arcLength = std::clamp(arcLength, 0.0, totalLength);
+    
+    if (kind != Kind::Segments)
+    {
+        return evaluateClosedForm(arcLength);
+    }
+    
+    segmentHint = locateSegment(arcLength, segmentHint);
+    
+    const Segment& segment = segments[static_cast<size_t>(segmentHint)];
+    const float t = static_cast<float>(std::min(1.0, (arcLength - segment.startArc) * segment.inverseLength));
+    
+    return Position(segment.startX + segment.deltaX * t, segment.startY + segment.deltaY * t);
+}
+
+void ScanPath::getPositions(const double* arcLengths, float* x, float* y, int numPositions, int& segmentHint) const
+{
+    if (isEmpty())
+    {
+        std::fill(x, x + numPositions, 0.0f);
+        std::fill(y, y + numPositions, 0.0f);
+        return;
+    }
+    
+    // Stateless evaluation, independent for every sample; the kind is chosen once per block
+    switch (kind)
+    {
+        case Kind::Curve:     evaluateBlock<Kind::Curve>(arcLengths, x, y, numPositions);     return;
+        case Kind::Morton:    evaluateBlock<Kind::Morton>(arcLengths, x, y, numPositions);    return;
+        case Kind::Diagonal:  evaluateBlock<Kind::Diagonal>(arcLengths, x, y, numPositions);  return;
+        case Kind::Spiral:    evaluateBlock<Kind::Spiral>(arcLengths, x, y, numPositions);    return;
+        case Kind::Segments:
+        default:              break;
+    }
+    
+    const int lastSegment = static_cast<int>(segments.size()) - 1;
+    int i = 0;
+    
+    while (i < numPositions)
+    {
+        segmentHint = locateSegment(arcLengths[i], segmentHint);
+        
+        const Segment& segment = segments[static_cast<size_t>(segmentHint)];
+        const double start = segment.startArc;
+        const double end = segmentHint == lastSegment ? totalLength + 1.0 : getSegmentEnd(segmentHint);
+        
+        // Extent of the run on this segment; a loop wrap or the segment end stops it
+        int runEnd = i + 1;
+        while (runEnd < numPositions && arcLengths[runEnd] >= start && arcLengths[runEnd] < end)
+        {
+            ++runEnd;
+        }
+        
+        // Straight-line interpolation over the run, free of branches
+        for (int j = i; j < runEnd; ++j)
+        {
+            const float t = static_cast<float>(std::min(1.0, (arcLengths[j] - start) * segment.inverseLength));
+            x[j] = segment.startX + segment.deltaX * t;
+            y[j] = segment.startY + segment.deltaY * t;
+        }
+        
+        i = runEnd;
+    }
+}
+
+Position ScanPath::getPositionAt(double arcLength) const
+{
+    int segmentHint = -1;
+    return getPositionAt(arcLength, segmentHint);
+}
+
+//==============================================================================
+ScanPathSet::~ScanPathSet()
+{
+    stopDeferredBuild();
+}
+
+void ScanPathSet::compile(Dimensions imageDimensions, bool deferTables)
+{
+    stopDeferredBuild();
+    dimensions = imageDimensions;
+    
+    for (int index = 0; index < numPatterns; ++index)
+    {
+        const auto pattern = static_cast<ScanPattern>(index);
+        
+        if (deferTables && pattern == ScanPattern::Hilbert)
+        {
+            paths[static_cast<size_t>(index)].compile(pattern, Dimensions());
+            continue;
+        }
+        
+        paths[static_cast<size_t>(index)].compile(pattern, dimensions);
+    }
+    
+    hilbertReady = !deferTables;
+    
+    if (!deferTables)
+    {
+        return;
+    }
+    
+    // Sleeps until the pattern is first selected, builds it once and exits
+    deferredBuilder = std::thread([this]
+    {
+        deferredRequested.wait(-1);
+        
+        if (deferredCancelled.load())
+        {
+            return;
+        }
+        
+        paths[static_cast<size_t>(ScanPattern::Hilbert)].compile(ScanPattern::Hilbert, dimensions);
+        hilbertReady.store(true, std::memory_order_release);
+    });
+}
+
+void ScanPathSet::stopDeferredBuild()
+{
+    if (deferredBuilder.joinable())
+    {
+        deferredCancelled = true;
+        deferredRequested.signal();
+        deferredBuilder.join();
+    }
+    
+    deferredCancelled = false;
+    deferredRequested.reset();
+    hilbertWanted = false;
+}
+
+bool ScanPathSet::request(ScanPattern pattern) const
+{
+    if (pattern != ScanPattern::Hilbert || hilbertReady.load(std::memory_order_acquire))
+    {
+        return true;
+    }
+    
+    if (!hilbertWanted.exchange(true))
+    {
+        deferredRequested.signal();
+    }
+    
+    return false;
+}
+
+const ScanPath& ScanPathSet::get(ScanPattern pattern) const
+{
+    if (pattern == ScanPattern::Hilbert && !hilbertReady.load(std::memory_order_acquire))
+    {
+        pattern = ScanPattern::Morton;
+    }
+    
+    const int index = std::clamp(static_cast<int>(pattern), 0, numPatterns - 1);
+    return paths[static_cast<size_t>(index)];
+}
@@ -0,0 +1,218 @@
+/*
+ * ScanPath.h - Precompiled scan paths for image traversal
+ * 
+ * Each ScanPattern is compiled once per image size, either into a table of
+ * straight segments indexed by arc length (raster patterns), into the
+ * parameters of a closed-form curve (diagonal and spiral) or into a table of
+ * pixel indices in visiting order (space-filling curves). Advancing a scan is
+ * then a phase increment plus a table read or a formula evaluation, and any
+ * position along the path can be looked up in constant time, which makes
+ * seeking and deterministic restarts free.
+ */
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "ScanTypes.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+//==============================================================================
+/**
+ * Path through an image, parameterised by arc length
+ * 
+ * Segments need not be connected: the jump from the end of one scanline to the
+ * start of the next takes no arc length. Compiling allocates; lookups don't.
+ * 
+ * Closed-form paths:
+ * - Diagonal: a serpentine raster of anti-diagonals, alternately up-right and
+ *   down-left, joined by unit steps along the image edge. It visits every pixel
+ *   once; the diagonal at an arc length is found by inverting the quadratic
+ *   arc length of the growing and shrinking corners.
+ * - Spiral: an Archimedean spiral from the centre out to the inscribed ellipse
+ *   with one pixel between turns along the longer axis. Arc length is exact
+ *   for square images up to the first turn, where the radial motion is ignored.
+ * 
+ * Space-filling curves (Hilbert, Morton) visit every pixel once. They are laid
+ * over the smallest power-of-two square covering the image, skipping cells
+ * outside it. Each pixel takes one unit of arc length; steps to a neighbouring
+ * pixel are interpolated, jumps (Morton quadrant changes, or skipped cells)
+ * are not. Morton cells are found in closed form by descending the quadrants
+ * clipped by the image edge and de-interleaving the bits of the remaining
+ * index; Hilbert is stored as one packed index per pixel.
+ */
+class ScanPath
+{
+public:
+    ScanPath() = default;
+    
+    /**
+     * Compile a pattern for the given image size (never call from the audio thread)
+     * @param pattern Scan pattern to compile
+     * @param dimensions Image dimensions
+     */
+    void compile(ScanPattern pattern, Dimensions dimensions);
+    
+    /**
+     * Get the position at a distance along the path
+     * @param arcLength Distance from the start in pixels, clamped to [0, getLength()]
+     * @param segmentHint Segment found by the previous lookup, or -1; updated in place.
+     *                    Sequential lookups with a hint skip the table search.
+     * @return Position on the path
+     */
+    Position getPositionAt(double arcLength, int& segmentHint) const;
+    
+    /**
+     * Get the position at a distance along the path without a hint
+     * @param arcLength Distance from the start in pixels
+     * @return Position on the path
+     */
+    Position getPositionAt(double arcLength) const;
+    
+    /**
+     * Get positions for a block of arc lengths in one pass
+     * Runs of arc lengths that stay on one segment are interpolated in a tight loop.
+     * @param arcLengths Distances from the start, each within [0, getLength()]
+     * @param x Output X coordinates
+     * @param y Output Y coordinates
+     * @param numPositions Number of positions
+     * @param segmentHint Segment found by the previous lookup, or -1; updated in place
+     */
+    void getPositions(const double* arcLengths, float* x, float* y, int numPositions, int& segmentHint) const;
+    
+    double getLength() const { return totalLength; }
+    bool isEmpty() const { return totalLength <= 0.0; }
+    ScanPattern getPattern() const { return pattern; }
+    Dimensions getDimensions() const { return dimensions; }
+    int getNumSegments() const { return static_cast<int>(segments.size()); }
+    
+private:
+    //==============================================================================
+    enum class Kind
+    {
+        Segments,
+        Diagonal,
+        Spiral,
+        Curve,
+        Morton
+    };
+    
+    struct Segment
+    {
+        float startX, startY;
+        float deltaX, deltaY;      // End minus start
+        double startArc;
+        double inverseLength;      // 1 / arc length of the segment
+    };
+    
+    void addSegment(Position from, Position to, double arcLength);
+    void addSerpentineRows();
+    void addSerpentineColumns();
+    void compileDiagonal();
+    double getDiagonalStart(int diagonal) const;
+    int findDiagonal(double arcLength) const;
+    Position getDiagonalStartPixel(int diagonal) const;
+    Position evaluateDiagonal(double arcLength) const;
+    void compileSpiral();
+    void compileCurve();
+    void compileMorton();
+    int getCurveSide() const;
+    Position getMortonCell(uint64_t visit) const;
+    Position evaluateMorton(double arcLength) const;
+    Position evaluateClosedForm(double arcLength) const;
+    Position evaluateCurve(double arcLength) const;
+    
+    template <Kind pathKind>
+    Position evaluate(double arcLength) const;
+    
+    template <Kind pathKind>
+    void evaluateBlock(const double* arcLengths, float* x, float* y, int numPositions) const;
+    
+    void buildLookup();
+    int findSegment(double arcLength) const;
+    int locateSegment(double arcLength, int segmentHint) const;
+    double getSegmentEnd(int index) const;
+    
+    ScanPattern pattern {ScanPattern::Horizontal};
+    Dimensions dimensions;
+    Kind kind {Kind::Segments};
+    std::vector<Segment> segments;
+    double totalLength {0.0};
+    
+    // Uniform arc-length buckets, each holding the first segment that overlaps it
+    std::vector<int> lookup;
+    double lookupScale {0.0};
+    
+    // Closed-form curve parameters
+    int shortSide {0}, longSide {0};        // Diagonal raster: min and max of (W, H)
+    int numDiagonals {0};                   // W + H - 1
+    double centreX {0.0}, centreY {0.0};    // Spiral centre
+    double radiusX {0.0}, radiusY {0.0};    // Spiral outer radii
+    double spiralTurns {1.0};
+    
+    // Hilbert curve pixels in visiting order, packed as x | (y << 16)
+    std::vector<uint32_t> curvePoints;
+    
+    // Side of the power-of-two square the Morton curve is laid over
+    int curveSide {0};
+};
+
+//==============================================================================
+/**
+ * Compiled paths of every scan pattern for one image size
+ * 
+ * Built off the audio thread alongside the image so switching patterns on the
+ * audio thread never compiles or allocates.
+ * 
+ * The Hilbert table holds one index per pixel, so a set compiled with deferred
+ * tables leaves it out until the pattern is first requested, then builds it on
+ * a helper thread. Until it is ready, get() returns the Morton path, the other
+ * space-filling curve, in its place.
+ */
+struct ScanPathSet
+{
+    static constexpr int numPatterns = static_cast<int>(ScanPattern::Morton) + 1;
+    
+    ScanPathSet() = default;
+    ~ScanPathSet();
+    
+    /**
+     * Compile all patterns for the given image size (never call from the audio thread)
+     * @param imageDimensions Image dimensions
+     * @param deferTables True to build the Hilbert table only once it is requested
+     */
+    void compile(Dimensions imageDimensions, bool deferTables = false);
+    
+    /**
+     * Ask for a pattern to be ready for get() (real-time safe)
+     * Wakes the helper thread the first time a deferred pattern is requested.
+     * @param pattern Scan pattern
+     * @return True if the pattern's own path is ready
+     */
+    bool request(ScanPattern pattern) const;
+    
+    /**
+     * Get the compiled path of a pattern
+     * @param pattern Scan pattern
+     * @return Compiled path, its stand-in while deferred, or empty if compile() has not been called
+     */
+    const ScanPath& get(ScanPattern pattern) const;
+    
+    std::array<ScanPath, numPatterns> paths;
+    Dimensions dimensions;
+    
+private:
+    //==============================================================================
+    void stopDeferredBuild();
+    
+    std::thread deferredBuilder;
+    juce::WaitableEvent deferredRequested;
+    std::atomic<bool> hilbertReady {false};
+    mutable std::atomic<bool> hilbertWanted {false};
+    std::atomic<bool> deferredCancelled {false};
+    
+    JUCE_DECLARE_NON_COPYABLE(ScanPathSet)
+};
@@ -0,0 +1,72 @@
+/*
+ * ScanTypes.h - Positions, dimensions and scan settings shared by the scan paths,
+ * the needle bank and the image loader
+ */
+
+#pragma once
+
+#include <cmath>
+#include "AudioSynthesis.h"
+
+//==============================================================================
+/**
+ * Position structure for 2D coordinates with sub-pixel precision
+ */
+struct Position
+{
+    float x, y;
+    
+    Position(float xPos = 0.0f, float yPos = 0.0f) : x(xPos), y(yPos) {}
+    
+    bool operator==(const Position& other) const
+    {
+        return std::abs(x - other.x) < 0.001f && std::abs(y - other.y) < 0.001f;
+    }
+};
+
+//==============================================================================
+/**
+ * Dimensions structure for width and height
+ */
+struct Dimensions
+{
+    int width, height;
+    
+    Dimensions(int w = 0, int h = 0) : width(w), height(h) {}
+    
+    bool isValid() const { return width > 0 && height > 0; }
+    int getArea() const { return width * height; }
+};
+
+//==============================================================================
+/**
+ * Scan pattern enumeration for different image traversal algorithms
+ */
+enum class ScanPattern
+{
+    Horizontal = 0,     // Left-to-right, alternating scanlines
+    Vertical,           // Top-to-bottom, alternating columns
+    Diagonal,           // Diagonal sweeps across image
+    Spiral,             // Spiral from center outward
+    Hilbert,            // Hilbert curve, always stepping to a neighbouring pixel
+    Morton              // Z-order curve, recursive quadrants
+};
+
+/**
+ * Source of the scan phase
+ */
+enum class TransportSync
+{
+    FreeRunning = 0,    // Advances with every processed sample
+    HostSamples,        // Derived from the host timeline position in samples
+    HostBeats           // Derived from the host PPQ position; scan speed is relative to 120 BPM
+};
+
+/**
+ * What starts the needles
+ */
+enum class TriggerMode
+{
+    FreeRunning = 0,    // Needles scan continuously, laid out by the needle parameters
+    Midi                // Each MIDI note starts a voice at the note's frequency
+};
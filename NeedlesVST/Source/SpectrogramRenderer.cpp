@@ -0,0 +1,276 @@
+/*
+ * SpectrogramRenderer.cpp - Column spectra, overlap-add and the ahead-of-playhead worker
+ */
+
+#include "SpectrogramRenderer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr double twoPi = 6.283185307179586;
+
+    // HSV hue in [0.0, 1.0); grey pixels have hue 0
+    float hueOf(float red, float green, float blue)
+    {
+        const float maximum = std::max({red, green, blue});
+        const float range = maximum - std::min({red, green, blue});
+
+        if (range <= 0.0f)
+        {
+            return 0.0f;
+        }
+
+        float hue;
+
+        if (maximum == red)
+            hue = (green - blue) / range;
+        else if (maximum == green)
+            hue = 2.0f + (blue - red) / range;
+        else
+            hue = 4.0f + (red - green) / range;
+
+        hue /= 6.0f;
+        return hue < 0.0f ? hue + 1.0f : hue;
+    }
+}
+
+//==============================================================================
+SpectrogramRenderer::SpectrogramRenderer()
+    : window(static_cast<size_t>(frameSize)),
+      frame(static_cast<size_t>(2 * frameSize), 0.0f),
+      overlap(static_cast<size_t>(frameSize), 0.0f),
+      binPhases(static_cast<size_t>(numBins), 0.0),
+      ring(static_cast<size_t>(bufferSize), 0.0f)
+{
+    // Periodic Hann; four overlapping windows sum to 2, so halve them
+    for (int i = 0; i < frameSize; ++i)
+    {
+        window[static_cast<size_t>(i)] = 0.25f * (1.0f - std::cos(static_cast<float>(twoPi * i / frameSize)));
+    }
+}
+
+SpectrogramRenderer::~SpectrogramRenderer()
+{
+    stopWorker();
+}
+
+void SpectrogramRenderer::prepare(const PixelPlanes& sourcePlanes)
+{
+    planes = sourcePlanes;
+    playhead = 0.0;
+    playing = false;
+    consumedSinceWake = 0;
+    flushDone.store(flushRequested.load());
+    fifo.reset();
+    std::fill(overlap.begin(), overlap.end(), 0.0f);
+
+    // Schroeder phases keep a fully lit column from summing into a click
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        binPhases[static_cast<size_t>(bin)] = std::fmod(twoPi / 2.0 * bin * bin / numBins, twoPi);
+    }
+}
+
+//==============================================================================
+void SpectrogramRenderer::startWorker()
+{
+    workerCancelled = false;
+    worker = std::thread([this]
+    {
+        const auto isCancelled = [this] { return workerCancelled.load(); };
+        const auto isInterrupted = [this] { return workerCancelled.load() || !playing.load(); };
+
+        // read() signals once it has made a hop of room; a full buffer or a pause sleeps
+        while (!isCancelled())
+        {
+            const uint32_t requested = flushRequested.load();
+
+            if (flushDone.load() != requested)
+            {
+                // The reader leaves the buffer alone until flushDone catches up
+                fifo.reset();
+                std::fill(overlap.begin(), overlap.end(), 0.0f);
+                flushDone.store(requested, std::memory_order_release);
+            }
+
+            if (!playing.load() || renderAhead(isInterrupted) == 0)
+            {
+                workerWake.wait(-1);
+            }
+        }
+    });
+}
+
+void SpectrogramRenderer::stopWorker()
+{
+    if (worker.joinable())
+    {
+        workerCancelled = true;
+        workerWake.signal();
+        worker.join();
+    }
+
+    workerWake.reset();
+}
+
+void SpectrogramRenderer::setSettings(const SpectrogramSettings& settings)
+{
+    if (settings.sampleRate != sampleRate.load())
+    {
+        flush();
+    }
+
+    sampleRate.store(settings.sampleRate);
+    columnsPerSecond.store(settings.columnsPerSecond);
+    formula.store(static_cast<int>(settings.formula));
+}
+
+//==============================================================================
+void SpectrogramRenderer::flush()
+{
+    playing.store(false);
+    flushRequested.fetch_add(1);
+    workerWake.signal();
+}
+
+int SpectrogramRenderer::read(float* output, int numSamples)
+{
+    if (flushDone.load(std::memory_order_acquire) != flushRequested.load())
+    {
+        // The worker owns the whole buffer until it has emptied it, so play silence
+        std::fill(output, output + numSamples, 0.0f);
+        return 0;
+    }
+
+    const bool wasPlaying = playing.exchange(true);
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(numSamples, start1, size1, start2, size2);
+
+    std::copy_n(ring.data() + start1, size1, output);
+    std::copy_n(ring.data() + start2, size2, output + size1);
+    fifo.finishedRead(size1 + size2);
+
+    const int numRead = size1 + size2;
+    std::fill(output + numRead, output + numSamples, 0.0f);
+
+    // The worker renders whole hops, so wake it once a hop of room has opened up,
+    // or straight away when playback resumes
+    consumedSinceWake += numRead;
+
+    if (!wasPlaying || consumedSinceWake >= hopSize)
+    {
+        consumedSinceWake = 0;
+        workerWake.signal();
+    }
+
+    return numRead;
+}
+
+int SpectrogramRenderer::renderAhead(const std::function<bool()>& shouldCancel)
+{
+    int numFrames = 0;
+
+    while (planes.isValid() && fifo.getNumReady() < leadSamples && fifo.getFreeSpace() >= hopSize)
+    {
+        if (shouldCancel && shouldCancel())
+        {
+            break;
+        }
+
+        renderFrame();
+        ++numFrames;
+    }
+
+    return numFrames;
+}
+
+//==============================================================================
+void SpectrogramRenderer::renderFrame()
+{
+    fillSpectrum(playhead, static_cast<ConversionFormula>(formula.load()));
+    fft.performRealOnlyInverseTransform(frame.data());
+
+    for (int i = 0; i < frameSize; ++i)
+    {
+        overlap[static_cast<size_t>(i)] += frame[static_cast<size_t>(i)] * window[static_cast<size_t>(i)];
+    }
+
+    // The first hop has received all its overlapping frames
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(hopSize, start1, size1, start2, size2);
+
+    std::copy_n(overlap.data(), size1, ring.data() + start1);
+    std::copy_n(overlap.data() + size1, size2, ring.data() + start2);
+    fifo.finishedWrite(size1 + size2);
+
+    std::copy(overlap.begin() + hopSize, overlap.end(), overlap.begin());
+    std::fill(overlap.end() - hopSize, overlap.end(), 0.0f);
+
+    const double columnsPerHop = columnsPerSecond.load() * hopSize / std::max(1.0, sampleRate.load());
+    playhead = std::fmod(playhead + columnsPerHop, static_cast<double>(planes.width));
+}
+
+void SpectrogramRenderer::fillSpectrum(double column, ConversionFormula conversionFormula)
+{
+    const ChannelWeights weights = getChannelWeights(conversionFormula);
+
+    // Bin magnitude of one pixel in [0.0, 1.0]
+    auto magnitudeAt = [&](int x, int y)
+    {
+        const size_t offset = planes.offsetOf(x, y);
+        const float red = planes.red[offset];
+        const float green = planes.green[offset];
+        const float blue = planes.blue[offset];
+
+        switch (conversionFormula)
+        {
+            case ConversionFormula::MaxChannel: return std::max({red, green, blue}) / 255.0f;
+            case ConversionFormula::MinChannel: return std::min({red, green, blue}) / 255.0f;
+            default: return (weights.red * red + weights.green * green + weights.blue * blue) / 255.0f;
+        }
+    };
+
+    const int leftColumn = static_cast<int>(column);
+    const int rightColumn = (leftColumn + 1) % planes.width;
+    const float columnFraction = static_cast<float>(column - leftColumn);
+    const int nearestColumn = columnFraction < 0.5f ? leftColumn : rightColumn;
+
+    // |X| = amplitude * N / 2 gives a sinusoid of that amplitude after the inverse transform
+    const float spectrumScale = getBinAmplitude() * static_cast<float>(numBins);
+    const double phaseAdvance = twoPi * hopSize / frameSize;
+
+    std::fill(frame.begin(), frame.end(), 0.0f);
+
+    for (int bin = 1; bin < numBins; ++bin)
+    {
+        // Bottom row at DC, top row just below Nyquist
+        const float row = (1.0f - static_cast<float>(bin) / numBins) * static_cast<float>(planes.height - 1);
+        const int upperRow = static_cast<int>(row);
+        const int lowerRow = std::min(upperRow + 1, planes.height - 1);
+        const float rowFraction = row - static_cast<float>(upperRow);
+
+        const float upper = magnitudeAt(leftColumn, upperRow)
+                          + columnFraction * (magnitudeAt(rightColumn, upperRow) - magnitudeAt(leftColumn, upperRow));
+        const float lower = magnitudeAt(leftColumn, lowerRow)
+                          + columnFraction * (magnitudeAt(rightColumn, lowerRow) - magnitudeAt(leftColumn, lowerRow));
+        const float magnitude = upper + rowFraction * (lower - upper);
+
+        double& binPhase = binPhases[static_cast<size_t>(bin)];
+
+        if (magnitude > 0.0f)
+        {
+            const size_t offset = planes.offsetOf(nearestColumn, rowFraction < 0.5f ? upperRow : lowerRow);
+            const float hue = hueOf(planes.red[offset], planes.green[offset], planes.blue[offset]);
+            const double phase = binPhase + twoPi * hue;
+            const float amplitude = magnitude * spectrumScale;
+
+            frame[static_cast<size_t>(2 * bin)] = amplitude * static_cast<float>(std::cos(phase));
+            frame[static_cast<size_t>(2 * bin + 1)] = amplitude * static_cast<float>(std::sin(phase));
+        }
+
+        // Advancing by one hop keeps a steady bin continuous across frames
+        binPhase = std::fmod(binPhase + phaseAdvance * bin, twoPi);
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ * SpectrogramRenderer.h - Inverse-FFT resynthesis of an image read as a spectrogram
+ *
+ * Each image column is one magnitude spectrum, with the bottom row at DC and
+ * the top row just below Nyquist. Columns are resynthesised with an inverse
+ * FFT and Hann-windowed overlap-add, with each pixel's hue offsetting the
+ * phase of its bin. FFT frames are bursty, so a worker thread renders ahead
+ * of the playhead into a lock-free ring buffer and the audio thread only
+ * copies finished samples out of it.
+ */
+
+#pragma once
+
+#include "ImageLoader.h"
+#include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <thread>
+#include <vector>
+
+//==============================================================================
+/**
+ * Playback settings, handed from the audio thread to the worker
+ */
+struct SpectrogramSettings
+{
+    double sampleRate {44100.0};                                // Rate the output is read at
+    float columnsPerSecond {40.0f};                             // Playhead speed across the image
+    ConversionFormula formula {ConversionFormula::WeightedRGB}; // Pixel to bin magnitude
+};
+
+//==============================================================================
+/**
+ * Spectrogram resynthesis of one image, rendered ahead on a worker thread
+ *
+ * Threading: prepare() and the worker controls run off the audio thread.
+ * setSettings(), read() and flush() are real-time safe and may be called from
+ * one reader thread while the worker runs. The worker sleeps until read() has
+ * consumed a hop, and nothing is rendered until the first read(), so an image
+ * that is never played as a spectrogram costs nothing.
+ */
+class SpectrogramRenderer
+{
+public:
+    static constexpr int fftOrder = 11;
+    static constexpr int frameSize = 1 << fftOrder;
+    static constexpr int hopSize = frameSize / 4;   // Periodic Hann windows at 75% overlap sum to 2
+    static constexpr int numBins = frameSize / 2;
+    static constexpr int bufferSize = 16384;
+    static constexpr int leadSamples = 8192;        // Samples kept rendered ahead of the reader
+
+    SpectrogramRenderer();
+    ~SpectrogramRenderer();
+
+    /**
+     * Point the renderer at an image and rewind it (not real-time safe; stop the worker first)
+     * @param planes Source planes; must outlive the renderer's use of them
+     */
+    void prepare(const PixelPlanes& planes);
+
+    /**
+     * Start or stop the worker thread that keeps the ring buffer topped up
+     */
+    void startWorker();
+    void stopWorker();
+
+    /**
+     * Set the playback settings used by frames rendered from now on (real-time safe)
+     * A new sample rate flushes the samples already rendered at the old one.
+     * @param settings Sample rate, playhead speed and magnitude formula
+     */
+    void setSettings(const SpectrogramSettings& settings);
+
+    /**
+     * Drop everything rendered ahead and pause until the next read() (real-time safe)
+     * Called when playback stops, so resuming doesn't replay stale samples.
+     */
+    void flush();
+
+    /**
+     * Copy rendered samples out of the ring buffer (real-time safe)
+     * Samples the worker hasn't rendered yet are returned as silence.
+     * @param output Array receiving numSamples samples
+     * @param numSamples Number of samples wanted
+     * @return Number of rendered samples copied before the silence
+     */
+    int read(float* output, int numSamples);
+
+    /**
+     * Render frames until the ring buffer holds leadSamples (worker thread only)
+     * @param shouldCancel Polled between frames; may be empty
+     * @return Number of frames rendered
+     */
+    int renderAhead(const std::function<bool()>& shouldCancel = {});
+
+    /**
+     * Amplitude of a bin whose pixel is at full magnitude
+     * A single lit row is a sinusoid at this level; a fully lit column is
+     * noise around full scale.
+     */
+    static float getBinAmplitude() { return 1.0f / std::sqrt(static_cast<float>(numBins)); }
+
+    double getPlayhead() const { return playhead; }
+
+private:
+    //==============================================================================
+    void renderFrame();
+    void fillSpectrum(double column, ConversionFormula formula);
+
+    PixelPlanes planes;
+    juce::dsp::FFT fft {fftOrder};
+    std::vector<float> window;          // Hann, scaled by the overlap-add gain
+    std::vector<float> frame;           // FFT work buffer, 2 * frameSize
+    std::vector<float> overlap;         // Overlap-add accumulator, frameSize
+    std::vector<double> binPhases;      // Running phase of each bin in radians
+    double playhead {0.0};              // Column position
+
+    juce::AbstractFifo fifo {bufferSize};
+    std::vector<float> ring;
+
+    std::atomic<double> sampleRate {44100.0};
+    std::atomic<float> columnsPerSecond {40.0f};
+    std::atomic<int> formula {static_cast<int>(ConversionFormula::WeightedRGB)};
+    std::atomic<bool> playing {false};
+    int consumedSinceWake {0};          // Samples read since the worker was last woken, reader only
+
+    // flush() bumps flushRequested; the worker empties the buffer and its partial
+    // frames and copies it to flushDone, and until then the reader plays silence
+    std::atomic<uint32_t> flushRequested {0};
+    std::atomic<uint32_t> flushDone {0};
+
+    std::thread worker;
+    juce::WaitableEvent workerWake;
+    std::atomic<bool> workerCancelled {false};
+};
@@ -20,14 +20,14 @@ std::pair<float, float> StereoProcessor::processRGBChannels(
     float redAudio, float greenAudio, float blueAudio,
     float redPan, float greenPan, float bluePan)
 {
-    // Process each RGB channel independently
-    auto [redLeft, redRight] = processPan(redAudio, redPan);
-    auto [greenLeft, greenRight] = processPan(greenAudio, greenPan);
-    auto [blueLeft, blueRight] = processPan(blueAudio, bluePan);
+    // Pans usually hold still for many samples, so the sin/cos law only runs on a change
+    const auto& [redLeftGain, redRightGain] = getCachedGains(redGains, redPan);
+    const auto& [greenLeftGain, greenRightGain] = getCachedGains(greenGains, greenPan);
+    const auto& [blueLeftGain, blueRightGain] = getCachedGains(blueGains, bluePan);
     
     // Mix RGB channels to final stereo output
-    float leftOutput = redLeft + greenLeft + blueLeft;
-    float rightOutput = redRight + greenRight + blueRight;
+    float leftOutput = redAudio * redLeftGain + greenAudio * greenLeftGain + blueAudio * blueLeftGain;
+    float rightOutput = redAudio * redRightGain + greenAudio * greenRightGain + blueAudio * blueRightGain;
     
     // Ensure output remains within valid range (prevent clipping)
     leftOutput = std::clamp(leftOutput, -1.0f, 1.0f);
@@ -36,6 +36,92 @@ std::pair<float, float> StereoProcessor::processRGBChannels(
     return {leftOutput, rightOutput};
 }
 
+//==============================================================================
+void StereoProcessor::computePanGains(const float* panPositions, float* leftGains, float* rightGains,
+                                      int numSamples)
+{
+    // Branch-free so the loop vectorises
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float position = (std::min(std::max(panPositions[i], -1.0f), 1.0f) + 1.0f) * 0.5f;
+        rightGains[i] = fastPanGain(position);
+        leftGains[i] = fastPanGain(1.0f - position);
+    }
+}
+
+//==============================================================================
+void StereoProcessor::processRGBBlock(const float* red, const float* green, const float* blue,
+                                      const RGBPanGains& gains, const float* outputGain,
+                                      float* left, float* right, int numSamples)
+{
+    // Each side is summed, gained and clamped in a stack chunk with JUCE's vector
+    // kernels, then added to the output
+    auto mix = [=](float* output, float redGain, float greenGain, float blueGain)
+    {
+        float sum[mixChunkSize];
+        
+        for (int start = 0; start < numSamples; start += mixChunkSize)
+        {
+            const int chunkSize = std::min(mixChunkSize, numSamples - start);
+            
+            juce::FloatVectorOperations::copyWithMultiply(sum, red + start, redGain, chunkSize);
+            juce::FloatVectorOperations::addWithMultiply(sum, green + start, greenGain, chunkSize);
+            juce::FloatVectorOperations::addWithMultiply(sum, blue + start, blueGain, chunkSize);
+            juce::FloatVectorOperations::multiply(sum, outputGain + start, chunkSize);
+            juce::FloatVectorOperations::clip(sum, sum, -1.0f, 1.0f, chunkSize);
+            juce::FloatVectorOperations::add(output + start, sum, chunkSize);
+        }
+    };
+    
+    // The 1/3 normalisation is folded into the pan gains
+    if (left != nullptr)
+        mix(left, gains.redLeft * rgbMixScale, gains.greenLeft * rgbMixScale, gains.blueLeft * rgbMixScale);
+    
+    if (right != nullptr)
+        mix(right, gains.redRight * rgbMixScale, gains.greenRight * rgbMixScale, gains.blueRight * rgbMixScale);
+}
+
+void StereoProcessor::processRGBBlock(const float* red, const float* green, const float* blue,
+                                      const RGBPanGainRamps& gains, const float* outputGain,
+                                      float* left, float* right, int numSamples)
+{
+    auto mix = [=](float* output, float scale, const float* redGain, const float* greenGain, const float* blueGain)
+    {
+        float sum[mixChunkSize];
+        
+        for (int start = 0; start < numSamples; start += mixChunkSize)
+        {
+            const int chunkSize = std::min(mixChunkSize, numSamples - start);
+            
+            juce::FloatVectorOperations::multiply(sum, red + start, redGain + start, chunkSize);
+            juce::FloatVectorOperations::addWithMultiply(sum, green + start, greenGain + start, chunkSize);
+            juce::FloatVectorOperations::addWithMultiply(sum, blue + start, blueGain + start, chunkSize);
+            juce::FloatVectorOperations::multiply(sum, outputGain + start, chunkSize);
+            juce::FloatVectorOperations::multiply(sum, scale, chunkSize);
+            juce::FloatVectorOperations::clip(sum, sum, -1.0f, 1.0f, chunkSize);
+            juce::FloatVectorOperations::add(output + start, sum, chunkSize);
+        }
+    };
+    
+    if (left != nullptr)
+        mix(left, gains.leftScale * rgbMixScale, gains.redLeft, gains.greenLeft, gains.blueLeft);
+    
+    if (right != nullptr)
+        mix(right, gains.rightScale * rgbMixScale, gains.redRight, gains.greenRight, gains.blueRight);
+}
+
+//==============================================================================
+const std::pair<float, float>& StereoProcessor::getCachedGains(CachedPanGains& cache, float pan)
+{
+    if (pan != cache.pan)
+    {
+        cache.pan = pan;
+        cache.gains = constantPowerPan(1.0f, clampPan(pan));
+    }
+    
+    return cache.gains;
+}
+
 //==============================================================================
 float StereoProcessor::clampPan(float pan)
 {
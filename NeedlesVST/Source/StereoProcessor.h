@@ -10,8 +10,34 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <utility>
 #include <cmath>
+#include <limits>
 #include <memory>
 
+//==============================================================================
+/**
+ * Left and right gains of each RGB channel, constant over a block
+ */
+struct RGBPanGains
+{
+    float redLeft {0.0f}, redRight {0.0f};
+    float greenLeft {0.0f}, greenRight {0.0f};
+    float blueLeft {0.0f}, blueRight {0.0f};
+};
+
+/**
+ * Per-sample left and right gains of each RGB channel, for pans that are ramping
+ */
+struct RGBPanGainRamps
+{
+    const float* redLeft {nullptr};
+    const float* redRight {nullptr};
+    const float* greenLeft {nullptr};
+    const float* greenRight {nullptr};
+    const float* blueLeft {nullptr};
+    const float* blueRight {nullptr};
+    float leftScale {1.0f}, rightScale {1.0f};  // Constant factor on each side, e.g. a needle's gain
+};
+
 //==============================================================================
 /**
  * Stereo processing interface for RGB channel panning
@@ -46,6 +72,44 @@ public:
     virtual std::pair<float, float> processRGBChannels(
         float redAudio, float greenAudio, float blueAudio,
         float redPan, float greenPan, float bluePan) = 0;
+    
+    /**
+     * Compute constant power gains for a ramp of pan positions
+     * Uses a polynomial approximation of the sin/cos law, so a ramp costs no
+     * transcendental calls; see StereoProcessor::maxFastGainError.
+     * @param panPositions Pan positions [-1.0, +1.0]; may be the leftGains array
+     * @param leftGains Receives the left gain of each position
+     * @param rightGains Receives the right gain of each position
+     * @param numSamples Number of positions
+     */
+    virtual void computePanGains(const float* panPositions, float* leftGains, float* rightGains,
+                                 int numSamples) = 0;
+    
+    /**
+     * Pan and mix a block of RGB channels using JUCE's vector kernels
+     * The three channels are summed through their pan gains, normalised by 1/3,
+     * scaled by the output gain and clamped to [-1.0, +1.0], and the result is
+     * added to the outputs so several sources can share one buffer.
+     * @param red Red channel audio
+     * @param green Green channel audio
+     * @param blue Blue channel audio
+     * @param gains Pan gains of each channel
+     * @param outputGain Per-sample output gain
+     * @param left Left output, e.g. an AudioBuffer channel; may be nullptr
+     * @param right Right output; may be nullptr
+     * @param numSamples Number of samples
+     */
+    virtual void processRGBBlock(const float* red, const float* green, const float* blue,
+                                 const RGBPanGains& gains, const float* outputGain,
+                                 float* left, float* right, int numSamples) = 0;
+    
+    /**
+     * Pan and mix a block of RGB channels with ramping pan gains
+     * As above, with a gain per sample for each channel and side.
+     */
+    virtual void processRGBBlock(const float* red, const float* green, const float* blue,
+                                 const RGBPanGainRamps& gains, const float* outputGain,
+                                 float* left, float* right, int numSamples) = 0;
 };
 
 //==============================================================================
@@ -67,6 +131,37 @@ public:
     std::pair<float, float> processRGBChannels(
         float redAudio, float greenAudio, float blueAudio,
         float redPan, float greenPan, float bluePan) override;
+    void computePanGains(const float* panPositions, float* leftGains, float* rightGains,
+                         int numSamples) override;
+    void processRGBBlock(const float* red, const float* green, const float* blue,
+                         const RGBPanGains& gains, const float* outputGain,
+                         float* left, float* right, int numSamples) override;
+    void processRGBBlock(const float* red, const float* green, const float* blue,
+                         const RGBPanGainRamps& gains, const float* outputGain,
+                         float* left, float* right, int numSamples) override;
+    
+    // Normalisation of the three summed colour channels
+    static constexpr float rgbMixScale = 1.0f / 3.0f;
+    
+    // Samples mixed per pass of processRGBBlock, in a stack buffer
+    static constexpr int mixChunkSize = 256;
+    
+    // Largest absolute difference between computePanGains and the exact sin/cos gains
+    static constexpr float maxFastGainError = 1.0e-6f;
+    
+    /**
+     * Polynomial approximation of sin(x * π/2) for x in [0.0, 1.0]
+     * The right gain of a pan is fastPanGain((pan + 1) / 2) and the left gain
+     * is the same with x mirrored, so hard pans silence the far side exactly.
+     * @param x Normalized position
+     * @return Gain within maxFastGainError of the exact value
+     */
+    static float fastPanGain(float x)
+    {
+        // Odd minimax fit over [0, 1]
+        const float x2 = x * x;
+        return x * (1.57079102f + x2 * (-0.645892936f + x2 * (0.0794345469f + x2 * -0.00433322712f)));
+    }
     
 private:
     /**
@@ -84,6 +179,25 @@ private:
      */
     static std::pair<float, float> constantPowerPan(float input, float pan);
     
+    /**
+     * Exact gains of the last pan position seen on one RGB channel
+     */
+    struct CachedPanGains
+    {
+        float pan {std::numeric_limits<float>::quiet_NaN()};  // Never equal, so the first lookup computes
+        std::pair<float, float> gains {0.0f, 0.0f};
+    };
+    
+    /**
+     * Gains for a pan position, recomputed only when the position changes
+     * @param cache Cache slot of one RGB channel
+     * @param pan Pan position, clamped before use
+     * @return Pair of (left, right) gains
+     */
+    static const std::pair<float, float>& getCachedGains(CachedPanGains& cache, float pan);
+    
+    CachedPanGains redGains, greenGains, blueGains;
+    
     // Constants for constant power panning
     static constexpr float PI_4 = 0.7853981633974483f;  // π/4
     static constexpr float SQRT_2_2 = 0.7071067811865476f;  // √2/2 (center level)
@@ -0,0 +1,200 @@
+/*
+ * WavetableBank.cpp - Wavetable extraction, mip construction and playback
+ */
+
+#include "WavetableBank.h"
+#include <juce_dsp/juce_dsp.h>
+#include <cmath>
+
+namespace
+{
+    // Fold a phase into [0.0, 1.0), including the rounding edge just below zero
+    double wrapPhase(double phase)
+    {
+        const double wrapped = phase - std::floor(phase);
+        return wrapped < 1.0 ? wrapped : 0.0;
+    }
+}
+
+//==============================================================================
+bool WavetableBank::build(const PixelPlanes& planes, WavetableAxis tableAxis, const std::function<bool()>& shouldCancel)
+{
+    clear();
+
+    if (!planes.isValid())
+    {
+        return false;
+    }
+
+    const bool rows = tableAxis == WavetableAxis::Rows;
+    const int lines = rows ? planes.height : planes.width;
+    const int lineLength = rows ? planes.width : planes.height;
+    const int tables = std::min(maxTables, lines);
+
+    // Each level keeps one extra sample so interpolation never wraps
+    size_t offset = 0;
+
+    for (int level = 0; level < numLevels; ++level)
+    {
+        levelOffsets[static_cast<size_t>(level)] = offset;
+        offset += static_cast<size_t>(getLevelSize(level) + 1);
+    }
+
+    cycleStride = offset;
+    cycles.assign(static_cast<size_t>(tables * numChannels) * cycleStride, 0.0f);
+
+    juce::dsp::FFT fft(fftOrder);
+    std::vector<float> spectrum(2 * tableSize);
+    std::vector<float> levelData(2 * tableSize);
+
+    for (int table = 0; table < tables; ++table)
+    {
+        if (shouldCancel && shouldCancel())
+        {
+            clear();
+            return false;
+        }
+
+        const int line = tables > 1 ? static_cast<int>(std::lround(static_cast<double>(table) * (lines - 1) / (tables - 1))) : 0;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const uint8_t* plane = channel == 0 ? planes.red : (channel == 1 ? planes.green : planes.blue);
+
+            auto pixel = [&](int index)
+            {
+                const size_t pixelOffset = rows ? planes.offsetOf(index, line) : planes.offsetOf(line, index);
+                return static_cast<float>(plane[pixelOffset]) / 127.5f - 1.0f;
+            };
+
+            // Stretch the line over one cycle; the last pixel leads back into the first
+            std::fill(spectrum.begin(), spectrum.end(), 0.0f);
+
+            for (int i = 0; i < tableSize; ++i)
+            {
+                const double position = static_cast<double>(i) * lineLength / tableSize;
+                const int index = static_cast<int>(position);
+                const float fraction = static_cast<float>(position - index);
+                const float current = pixel(index);
+                const float next = pixel((index + 1) % lineLength);
+                spectrum[static_cast<size_t>(i)] = current + fraction * (next - current);
+            }
+
+            fft.performRealOnlyForwardTransform(spectrum.data(), true);
+
+            // An image's brightness is an offset, not a tone
+            spectrum[0] = 0.0f;
+            spectrum[1] = 0.0f;
+
+            for (int level = 0; level < numLevels; ++level)
+            {
+                std::copy(spectrum.begin(), spectrum.begin() + tableSize + 2, levelData.begin());
+
+                for (int bin = getMaxHarmonics(level) + 1; bin <= tableSize / 2; ++bin)
+                {
+                    levelData[static_cast<size_t>(2 * bin)] = 0.0f;
+                    levelData[static_cast<size_t>(2 * bin + 1)] = 0.0f;
+                }
+
+                fft.performRealOnlyInverseTransform(levelData.data());
+
+                // Band-limited below half the level size, so plain decimation is exact
+                const int levelSize = getLevelSize(level);
+                const int step = tableSize / levelSize;
+                float* cycle = cycles.data() + static_cast<size_t>(table * numChannels + channel) * cycleStride
+                             + levelOffsets[static_cast<size_t>(level)];
+
+                for (int i = 0; i < levelSize; ++i)
+                {
+                    cycle[i] = levelData[static_cast<size_t>(i * step)];
+                }
+
+                cycle[levelSize] = cycle[0];
+            }
+        }
+    }
+
+    axis = tableAxis;
+    numLines = lines;
+    numTables = tables;
+    return true;
+}
+
+void WavetableBank::clear()
+{
+    cycles.clear();
+    cycles.shrink_to_fit();
+    cycleStride = 0;
+    numTables = 0;
+    numLines = 0;
+}
+
+//==============================================================================
+int WavetableBank::getLevelForFrequency(double cyclesPerSample)
+{
+    const double frequency = std::abs(cyclesPerSample);
+
+    for (int level = 0; level < numLevels; ++level)
+    {
+        if (getMaxHarmonics(level) * frequency <= 0.5)
+        {
+            return level;
+        }
+    }
+
+    return numLevels - 1;
+}
+
+const float* WavetableBank::getCycle(int table, int channel, int level) const
+{
+    return cycles.data() + static_cast<size_t>(table * numChannels + channel) * cycleStride
+         + levelOffsets[static_cast<size_t>(level)];
+}
+
+void WavetableBank::render(const float* positions, double& phase, double cyclesPerSample,
+                           float* red, float* green, float* blue, int numSamples) const
+{
+    if (numTables == 0)
+    {
+        std::fill(red, red + numSamples, 0.0f);
+        std::fill(green, green + numSamples, 0.0f);
+        std::fill(blue, blue + numSamples, 0.0f);
+        return;
+    }
+
+    const int level = getLevelForFrequency(cyclesPerSample);
+    const double levelSize = static_cast<double>(getLevelSize(level));
+    const float lastTable = static_cast<float>(numTables - 1);
+    const float tableScale = numLines > 1 ? lastTable / static_cast<float>(numLines - 1) : 0.0f;
+
+    float* outputs[numChannels] = {red, green, blue};
+    phase = wrapPhase(phase);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float tablePosition = juce::jlimit(0.0f, lastTable, positions[i] * tableScale);
+        const int lowerTable = static_cast<int>(tablePosition);
+        const int upperTable = std::min(lowerTable + 1, numTables - 1);
+        const float morph = tablePosition - static_cast<float>(lowerTable);
+
+        const double readPosition = phase * levelSize;
+        const int index = static_cast<int>(readPosition);
+        const float fraction = static_cast<float>(readPosition - index);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const float* lower = getCycle(lowerTable, channel, level) + index;
+            const float* upper = getCycle(upperTable, channel, level) + index;
+            const float lowerValue = lower[0] + fraction * (lower[1] - lower[0]);
+            const float upperValue = upper[0] + fraction * (upper[1] - upper[0]);
+            outputs[channel][i] = lowerValue + morph * (upperValue - lowerValue);
+        }
+
+        phase += cyclesPerSample;
+
+        if (phase >= 1.0 || phase < 0.0)
+        {
+            phase = wrapPhase(phase);
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/*
+ * WavetableBank.h - Single-cycle wavetables taken from image scanlines
+ *
+ * Each selected row (or column) of the image becomes one cycle of a periodic
+ * waveform. Every table is stored as a set of band-limited mip levels, built
+ * once with an FFT, so an oscillator can play it at any pitch without
+ * aliasing by reading the level whose highest harmonic stays below Nyquist.
+ */
+
+#pragma once
+
+#include "ImageLoader.h"
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <vector>
+
+//==============================================================================
+/**
+ * Band-limited R/G/B wavetables for one image axis
+ *
+ * Built once off the audio thread and read-only afterwards, so rendering is
+ * safe from any thread once build() has returned.
+ */
+class WavetableBank
+{
+public:
+    static constexpr int fftOrder = 11;
+    static constexpr int tableSize = 1 << fftOrder;  // Samples per cycle at level 0
+    static constexpr int maxTables = 64;             // Lines are sampled evenly beyond this
+    static constexpr int numLevels = 10;             // tableSize / 4 harmonics halving down to 1
+    static constexpr int minLevelSize = 64;          // Shortest stored cycle
+    static constexpr int numChannels = 3;
+
+    WavetableBank() = default;
+
+    /**
+     * Build the tables and their mip levels (never call from the audio thread)
+     * @param planes Source planes; only read during the build
+     * @param axis Whether rows or columns become tables
+     * @param shouldCancel Polled between tables; may be empty
+     * @return false if the planes were invalid or the build was cancelled
+     */
+    bool build(const PixelPlanes& planes, WavetableAxis axis, const std::function<bool()>& shouldCancel = {});
+
+    /**
+     * Render an oscillator that morphs between tables (real-time safe)
+     * The mip level is chosen once per call from the frequency.
+     * @param positions Array of scan coordinates across the lines (y for rows, x for columns)
+     * @param phase Oscillator phase in cycles [0.0, 1.0), advanced on return
+     * @param cyclesPerSample Oscillator frequency divided by the sample rate
+     * @param red Array receiving the red waveform in [-1.0, 1.0]
+     * @param green Array receiving the green waveform in [-1.0, 1.0]
+     * @param blue Array receiving the blue waveform in [-1.0, 1.0]
+     * @param numSamples Number of samples to render
+     */
+    void render(const float* positions, double& phase, double cyclesPerSample,
+                float* red, float* green, float* blue, int numSamples) const;
+
+    /**
+     * Lowest mip level whose harmonics all stay below Nyquist
+     * @param cyclesPerSample Oscillator frequency divided by the sample rate
+     * @return Level index, the coarsest level when even that would alias
+     */
+    static int getLevelForFrequency(double cyclesPerSample);
+
+    static int getMaxHarmonics(int level) { return (tableSize / 4) >> level; }
+    static int getLevelSize(int level) { return std::max(minLevelSize, tableSize >> level); }
+
+    /**
+     * Stored cycle of one table channel at one level
+     * @return getLevelSize(level) samples followed by a copy of the first
+     */
+    const float* getCycle(int table, int channel, int level) const;
+
+    bool isBuilt() const { return numTables > 0; }
+    int getNumTables() const { return numTables; }
+    int getNumLines() const { return numLines; }
+    WavetableAxis getAxis() const { return axis; }
+
+private:
+    //==============================================================================
+    void clear();
+
+    WavetableAxis axis {WavetableAxis::Rows};
+    int numTables {0};
+    int numLines {0};                          // Rows or columns in the source image
+    std::array<size_t, numLevels> levelOffsets {};
+    size_t cycleStride {0};                    // All levels of one table channel
+    std::vector<float> cycles;                 // [table][channel][level][sample]
+};
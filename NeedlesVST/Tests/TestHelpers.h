@@ -1,13 +1,18 @@
 #pragma once
 
 #include <catch2/catch_all.hpp>
-#include <JuceHeader.h>
+#include <juce_graphics/juce_graphics.h>
+#include "../Source/ImageLoader.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
 
 namespace TestHelpers {
     /**
      * Helper to create test images programmatically
      */
-    juce::Image createTestImage(int width, int height, const juce::Colour& color) {
+    inline juce::Image createTestImage(int width, int height, const juce::Colour& color) {
         juce::Image img(juce::Image::RGB, width, height, true);
         juce::Graphics g(img);
         g.fillAll(color);
@@ -17,7 +22,7 @@ namespace TestHelpers {
     /**
      * Helper to create gradient test image
      */
-    juce::Image createGradientImage(int width, int height) {
+    inline juce::Image createGradientImage(int width, int height) {
         juce::Image img(juce::Image::RGB, width, height, true);
         juce::Graphics g(img);
         juce::ColourGradient gradient(juce::Colours::black, 0, 0, 
@@ -30,7 +35,7 @@ namespace TestHelpers {
     /**
      * Helper to compare float values with tolerance
      */
-    bool floatEqual(float a, float b, float tolerance = 0.001f) {
+    inline bool floatEqual(float a, float b, float tolerance = 0.001f) {
         return std::abs(a - b) < tolerance;
     }
     
@@ -45,4 +50,42 @@ namespace TestHelpers {
             return red == other.red && green == other.green && blue == other.blue;
         }
     };
+    
+    /**
+     * Owned planar RGB image with a PixelPlanes view onto it
+     */
+    struct TestPlanes {
+        TestPlanes(int width, int height)
+            : red(static_cast<size_t>(width * height)),
+              green(static_cast<size_t>(width * height)),
+              blue(static_cast<size_t>(width * height)) {
+            view.red = red.data();
+            view.green = green.data();
+            view.blue = blue.data();
+            view.width = width;
+            view.height = height;
+            view.stride = width;
+        }
+        
+        /**
+         * Fill every pixel from pixel(x, y, channel), channel 0, 1, 2 being red, green, blue
+         */
+        TestPlanes(int width, int height, const std::function<uint8_t(int, int, int)>& pixel)
+            : TestPlanes(width, height) {
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    const size_t offset = static_cast<size_t>(y * width + x);
+                    red[offset] = pixel(x, y, 0);
+                    green[offset] = pixel(x, y, 1);
+                    blue[offset] = pixel(x, y, 2);
+                }
+            }
+        }
+        
+        TestPlanes(const TestPlanes&) = delete;
+        TestPlanes& operator=(const TestPlanes&) = delete;
+        
+        std::vector<uint8_t> red, green, blue;
+        PixelPlanes view;
+    };
 }
@@ -140,4 +140,121 @@ TEST_CASE("AudioSynthesis Contract - Gain Control", "[AudioSynthesis][US1]")
         
         FAIL("Test not yet implemented - waiting for concrete AudioSynthesis class");
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("AudioSynthesis block conversion matches per-pixel conversion", "[AudioSynthesis][convertBlock]")
+{
+    auto synthesis = createAudioSynthesis();
+    synthesis->setGain(1.5f);
+    
+    // Odd length exercises both the vector kernels and the scalar tail
+    constexpr int numSamples = 203;
+    std::vector<uint8_t> red(numSamples), green(numSamples), blue(numSamples);
+    std::vector<float> output(numSamples), gainRamp(numSamples);
+    
+    for (int i = 0; i < numSamples; ++i)
+    {
+        red[i] = static_cast<uint8_t>((i * 37) & 0xff);
+        green[i] = static_cast<uint8_t>((i * 91 + 13) & 0xff);
+        blue[i] = static_cast<uint8_t>((255 - i * 7) & 0xff);
+        gainRamp[i] = static_cast<float>(i) / numSamples * 2.0f;
+    }
+    
+    const ConversionFormula formulas[] = {
+        ConversionFormula::RGBAverage, ConversionFormula::WeightedRGB, ConversionFormula::RedChannel,
+        ConversionFormula::GreenChannel, ConversionFormula::BlueChannel, ConversionFormula::MaxChannel,
+        ConversionFormula::MinChannel
+    };
+    
+    SECTION("Constant gain")
+    {
+        for (auto formula : formulas)
+        {
+            synthesis->convertBlock(red.data(), green.data(), blue.data(), output.data(), numSamples, formula);
+            
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float expected = synthesis->rgbToAudio(RGB(red[i], green[i], blue[i]), formula);
+                REQUIRE(TestHelpers::floatEqual(output[i], expected, 1.0e-5f));
+            }
+        }
+    }
+    
+    SECTION("Per-sample gain ramp")
+    {
+        for (auto formula : formulas)
+        {
+            synthesis->convertBlock(red.data(), green.data(), blue.data(), output.data(), numSamples,
+                                    formula, gainRamp.data());
+            
+            for (int i = 0; i < numSamples; ++i)
+            {
+                synthesis->setGain(gainRamp[i]);
+                const float expected = synthesis->rgbToAudio(RGB(red[i], green[i], blue[i]), formula);
+                REQUIRE(TestHelpers::floatEqual(output[i], expected, 1.0e-5f));
+                REQUIRE(output[i] >= -1.0f);
+                REQUIRE(output[i] <= 1.0f);
+            }
+        }
+    }
+    
+    SECTION("Channels split in one pass")
+    {
+        std::vector<float> greenOutput(numSamples), blueOutput(numSamples);
+        synthesis->convertChannels(red.data(), green.data(), blue.data(),
+                                   output.data(), greenOutput.data(), blueOutput.data(), numSamples);
+        
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const RGB rgb(red[i], green[i], blue[i]);
+            REQUIRE(TestHelpers::floatEqual(output[i], rgb.toAudioChannel(0), 1.0e-5f));
+            REQUIRE(TestHelpers::floatEqual(greenOutput[i], rgb.toAudioChannel(1), 1.0e-5f));
+            REQUIRE(TestHelpers::floatEqual(blueOutput[i], rgb.toAudioChannel(2), 1.0e-5f));
+        }
+    }
+}
+
+TEST_CASE("AudioSynthesis lookup tables match the arithmetic conversions", "[AudioSynthesis][tables]")
+{
+    static_assert(ConversionTables::byteToAudio[0] == -1.0f, "Tables are generated at compile time");
+    
+    for (int value = 0; value < 256; ++value)
+    {
+        const uint8_t byte = static_cast<uint8_t>(value);
+        const float expected = (static_cast<float>(value) / 255.0f) * 2.0f - 1.0f;
+        
+        REQUIRE(TestHelpers::floatEqual(RGB(byte, 0, 0).toAudioChannel(0), expected, 1.0e-6f));
+        REQUIRE(TestHelpers::floatEqual(RGB(0, 0, byte).toAudioChannel(2), expected, 1.0e-6f));
+    }
+    
+    for (int red = 0; red < 256; red += 17)
+    {
+        for (int green = 0; green < 256; green += 51)
+        {
+            for (int blue = 0; blue < 256; blue += 85)
+            {
+                const RGB rgb(static_cast<uint8_t>(red), static_cast<uint8_t>(green), static_cast<uint8_t>(blue));
+                const float average = (static_cast<float>(red) + green + blue) / (3.0f * 255.0f) * 2.0f - 1.0f;
+                const float luminance = (0.2126f * red + 0.7152f * green + 0.0722f * blue) / 255.0f * 2.0f - 1.0f;
+                
+                REQUIRE(TestHelpers::floatEqual(rgb.toAudioSimple(), average, 1.0e-5f));
+                REQUIRE(TestHelpers::floatEqual(rgb.toAudioWeighted(), luminance, 1.0e-5f));
+            }
+        }
+    }
+    
+    SECTION("Changing the gain refolds the tables")
+    {
+        auto synthesis = createAudioSynthesis();
+        const RGB rgb(200, 40, 90);
+        const float unity = synthesis->rgbToAudio(rgb, ConversionFormula::WeightedRGB);
+        
+        synthesis->setGain(0.5f);
+        REQUIRE(TestHelpers::floatEqual(synthesis->rgbToAudio(rgb, ConversionFormula::WeightedRGB), unity * 0.5f, 1.0e-6f));
+        REQUIRE(TestHelpers::floatEqual(synthesis->rgbToAudio(rgb, ConversionFormula::MaxChannel),
+                                        rgb.toAudioChannel(0) * 0.5f, 1.0e-6f));
+        
+        synthesis->setGain(0.0f);
+        REQUIRE(synthesis->rgbToAudio(rgb, ConversionFormula::MinChannel) == 0.0f);
+    }
+}
@@ -0,0 +1,144 @@
+/*
+ * ImageLoadThreadTest.cpp - Unit tests for background image loading
+ *
+ * Validates that cancelled loads are abandoned without an error or a
+ * snapshot, and that a load superseded by a newer request is never
+ * published over the newer image.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "../../Source/ImageLoadThread.h"
+
+#include <chrono>
+#include <thread>
+
+namespace
+{
+    /**
+     * Solid colour image written to a temporary PNG, deleted with the object
+     */
+    struct TemporaryImageFile
+    {
+        TemporaryImageFile(int width, int height, juce::Colour colour)
+            : file(juce::File::createTempFile(".png"))
+        {
+            juce::Image image(juce::Image::RGB, width, height, false);
+            image.clear(image.getBounds(), colour);
+
+            juce::FileOutputStream stream(file);
+            juce::PNGImageFormat png;
+            png.writeImageToStream(image, stream);
+        }
+
+        ~TemporaryImageFile() { file.deleteFile(); }
+
+        juce::String getPath() const { return file.getFullPathName(); }
+
+        juce::File file;
+    };
+
+    std::string getPublishedPath(ImagePublisher& publisher)
+    {
+        ImagePublisher::ReadScope scope(publisher);
+        return scope.get() != nullptr ? scope.get()->filePath : std::string();
+    }
+
+    bool waitForPublishedPath(ImagePublisher& publisher, const juce::String& path, int timeoutMs)
+    {
+        for (int elapsed = 0; elapsed < timeoutMs; elapsed += 10)
+        {
+            if (getPublishedPath(publisher) == path.toStdString())
+                return true;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        return false;
+    }
+}
+
+//==============================================================================
+TEST_CASE("ImageLoadThread abandons cancelled loads", "[ImageLoadThread]")
+{
+    TemporaryImageFile image(64, 48, juce::Colours::red);
+    TemporaryImageFile previous(16, 16, juce::Colours::blue);
+    juce::String errorMessage;
+
+    SECTION("Cancelled before decoding")
+    {
+        LoadObserver observer;
+        observer.shouldCancel = [] { return true; };
+
+        REQUIRE(ImageLoadThread::buildSnapshot(image.getPath(), observer, errorMessage) == nullptr);
+        REQUIRE(errorMessage.isEmpty());
+    }
+
+    SECTION("Cancelled once decoding has started")
+    {
+        // 0.05 is reported before decoding; everything above it comes from inside loadImage
+        float cancelledAt = 0.0f;
+
+        LoadObserver observer;
+        observer.onProgress = [&cancelledAt](float progress)
+        {
+            if (progress > 0.05f && cancelledAt == 0.0f)
+                cancelledAt = progress;
+        };
+        observer.shouldCancel = [&cancelledAt] { return cancelledAt > 0.0f; };
+
+        ImagePublisher publisher;
+        publisher.publish(ImageLoadThread::buildSnapshot(previous.getPath(), {}, errorMessage));
+
+        auto snapshot = ImageLoadThread::buildSnapshot(image.getPath(), observer, errorMessage);
+
+        REQUIRE(cancelledAt > 0.05f);
+        REQUIRE(snapshot == nullptr);
+        REQUIRE(errorMessage.isEmpty());
+        REQUIRE(getPublishedPath(publisher) == previous.getPath().toStdString());
+    }
+
+    SECTION("An uncancelled load prepares a snapshot")
+    {
+        auto snapshot = ImageLoadThread::buildSnapshot(image.getPath(), {}, errorMessage);
+
+        REQUIRE(snapshot != nullptr);
+        REQUIRE(snapshot->dimensions.width == 64);
+        REQUIRE(snapshot->dimensions.height == 48);
+        REQUIRE(snapshot->filePath == image.getPath().toStdString());
+    }
+}
+
+//==============================================================================
+TEST_CASE("ImageLoadThread drops superseded loads", "[ImageLoadThread]")
+{
+    // The large image takes long enough to decode that it is still loading when superseded
+    TemporaryImageFile large(2048, 2048, juce::Colours::green);
+    TemporaryImageFile small(16, 16, juce::Colours::blue);
+
+    ImagePublisher publisher;
+    ImageLoadThread loadThread(publisher);
+
+    SECTION("A newer request replaces one in progress")
+    {
+        loadThread.requestLoad(large.getPath());
+        loadThread.requestLoad(small.getPath());
+
+        REQUIRE(waitForPublishedPath(publisher, small.getPath(), 10000));
+
+        // Had the superseded load finished anyway, it would now replace the newer image
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        REQUIRE(getPublishedPath(publisher) == small.getPath().toStdString());
+    }
+
+    SECTION("A cancelled request is never published")
+    {
+        loadThread.requestLoad(small.getPath());
+        REQUIRE(waitForPublishedPath(publisher, small.getPath(), 10000));
+
+        loadThread.requestLoad(large.getPath());
+        loadThread.cancelPendingLoad();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        REQUIRE(getPublishedPath(publisher) == small.getPath().toStdString());
+    }
+}
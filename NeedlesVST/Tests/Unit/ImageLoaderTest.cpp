@@ -140,4 +140,132 @@ TEST_CASE("ImageLoader Contract - Get Area Average", "[ImageLoader][US1]")
         
         FAIL("Test not yet implemented - waiting for concrete ImageLoader class");
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("ImageLoader summed-area table matches brute-force averages", "[ImageLoader][AreaTable]")
+{
+    // Round-trip a generated gradient through a temporary PNG
+    auto image = TestHelpers::createGradientImage(97, 61);
+    auto tempFile = juce::File::createTempFile(".png");
+    
+    {
+        juce::FileOutputStream stream(tempFile);
+        juce::PNGImageFormat png;
+        REQUIRE(png.writeImageToStream(image, stream));
+    }
+    
+    auto loader = createImageLoader();
+    REQUIRE(loader->loadImage(tempFile.getFullPathName().toStdString()).success);
+    
+    const auto planes = loader->getPixelPlanes();
+    REQUIRE(planes.isValid());
+    
+    auto bruteForceAverage = [&](int centerX, int centerY, int areaSize)
+    {
+        const int halfSize = (areaSize | 1) / 2;
+        const int minX = std::max(0, centerX - halfSize), maxX = std::min(planes.width - 1, centerX + halfSize);
+        const int minY = std::max(0, centerY - halfSize), maxY = std::min(planes.height - 1, centerY + halfSize);
+        
+        long totalR = 0, totalG = 0, totalB = 0;
+        for (int y = minY; y <= maxY; ++y)
+        {
+            for (int x = minX; x <= maxX; ++x)
+            {
+                const size_t offset = planes.offsetOf(x, y);
+                totalR += planes.red[offset];
+                totalG += planes.green[offset];
+                totalB += planes.blue[offset];
+            }
+        }
+        
+        const long count = static_cast<long>(maxX - minX + 1) * (maxY - minY + 1);
+        return RGB{static_cast<uint8_t>(totalR / count),
+                   static_cast<uint8_t>(totalG / count),
+                   static_cast<uint8_t>(totalB / count)};
+    };
+    
+    SECTION("Full advertised area size range, including image edges")
+    {
+        const int positions[][2] = {{0, 0}, {48, 30}, {96, 60}, {10, 55}, {90, 3}};
+        
+        for (int areaSize : {1, 2, 5, 10, 21, 50})
+        {
+            for (const auto& position : positions)
+            {
+                const RGB expected = bruteForceAverage(position[0], position[1], areaSize);
+                const RGB actual = loader->getAreaAverage(static_cast<float>(position[0]),
+                                                          static_cast<float>(position[1]), areaSize);
+                
+                INFO("areaSize " << areaSize << " at " << position[0] << "," << position[1]);
+                REQUIRE(actual.red == expected.red);
+                REQUIRE(actual.green == expected.green);
+                REQUIRE(actual.blue == expected.blue);
+            }
+        }
+    }
+    
+    tempFile.deleteFile();
+}
+
+TEST_CASE("ImageLoader planar conversion round-trips interleaved pixels", "[ImageLoader][Planes]")
+{
+    // Odd width, so every row ends inside the aligned plane stride
+    constexpr int width = 37;
+    constexpr int height = 5;
+    
+    auto expectedPixel = [](int x, int y)
+    {
+        return RGB{static_cast<uint8_t>(x * 7), static_cast<uint8_t>(y * 50 + 3), static_cast<uint8_t>(255 - x - y)};
+    };
+    
+    for (auto format : { juce::Image::RGB, juce::Image::ARGB })
+    {
+        juce::Image image(format, width, height, true);
+        
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                const RGB pixel = expectedPixel(x, y);
+                image.setPixelAt(x, y, juce::Colour(pixel.red, pixel.green, pixel.blue));
+            }
+        }
+        
+        auto tempFile = juce::File::createTempFile(".png");
+        
+        {
+            juce::FileOutputStream stream(tempFile);
+            juce::PNGImageFormat png;
+            REQUIRE(png.writeImageToStream(image, stream));
+        }
+        
+        auto loader = createImageLoader();
+        REQUIRE(loader->loadImage(tempFile.getFullPathName().toStdString()).success);
+        
+        const auto planes = loader->getPixelPlanes();
+        REQUIRE(planes.width == width);
+        REQUIRE(planes.height == height);
+        REQUIRE(planes.stride >= width);
+        REQUIRE(planes.stride % PixelPlanes::planeAlignment == 0);
+        
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                const RGB expected = expectedPixel(x, y);
+                const RGB actual = loader->getPixel(static_cast<float>(x), static_cast<float>(y));
+                const size_t offset = planes.offsetOf(x, y);
+                
+                INFO("format " << static_cast<int>(format) << " pixel " << x << "," << y);
+                REQUIRE(actual.red == expected.red);
+                REQUIRE(actual.green == expected.green);
+                REQUIRE(actual.blue == expected.blue);
+                REQUIRE(planes.red[offset] == expected.red);
+                REQUIRE(planes.green[offset] == expected.green);
+                REQUIRE(planes.blue[offset] == expected.blue);
+            }
+        }
+        
+        tempFile.deleteFile();
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * ImagePublisherTest.cpp - Unit tests for lock-free image publication
+ *
+ * Validates that published snapshots become visible to the reader, that a
+ * snapshot is never reclaimed while it is being read, and that retired
+ * snapshots are eventually freed on the reclamation thread.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "../../Source/ImagePublisher.h"
+
+#include <atomic>
+#include <thread>
+
+namespace
+{
+    /**
+     * Minimal loader that reports its destruction
+     */
+    class TrackedLoader : public IImageLoader
+    {
+    public:
+        explicit TrackedLoader(std::atomic<bool>& destroyedFlag) : destroyed(destroyedFlag) {}
+        ~TrackedLoader() override { destroyed = true; }
+
+        LoadResult loadImage(const std::string&, const LoadObserver& = {}) override { return LoadResult(true); }
+        RGB getPixel(float, float) const override { return {}; }
+        RGB getAreaAverage(float, float, int, BlurShape) const override { return {}; }
+        void getAreaAverages(const float*, const float*, const float*, int,
+                             uint8_t*, uint8_t*, uint8_t*, BlurShape) const override {}
+        void setSampleCacheOptions(const SampleCacheOptions&) override {}
+        bool getAreaSamples(const float*, const float*, const float*, int,
+                            float*, ConversionFormula, BlurShape) const override { return false; }
+        bool isPyramidReady() const override { return false; }
+        const WavetableBank* getWavetables(WavetableAxis) const override { return nullptr; }
+        SpectrogramRenderer* getSpectrogram() const override { return nullptr; }
+        ImpulseResponseBuilder* getImpulseResponseBuilder() const override { return nullptr; }
+        Dimensions getDimensions() const override { return {2, 2}; }
+        bool isLoaded() const override { return true; }
+        void clearImage() override {}
+        std::string getFilePath() const override { return {}; }
+        juce::Image getImage() const override { return {}; }
+        PixelPlanes getPixelPlanes() const override { return {}; }
+        bool isValidPosition(float, float) const override { return true; }
+
+    private:
+        std::atomic<bool>& destroyed;
+    };
+
+    std::unique_ptr<ImageSnapshot> makeSnapshot(std::atomic<bool>& destroyedFlag)
+    {
+        auto snapshot = std::make_unique<ImageSnapshot>();
+        snapshot->loader = std::make_unique<TrackedLoader>(destroyedFlag);
+        snapshot->dimensions = {2, 2};
+        return snapshot;
+    }
+
+    bool waitFor(const std::atomic<bool>& flag, int timeoutMs)
+    {
+        for (int elapsed = 0; elapsed < timeoutMs && !flag.load(); elapsed += 10)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        return flag.load();
+    }
+}
+
+//==============================================================================
+TEST_CASE("ImagePublisher publishes snapshots to the reader", "[publisher][rcu]")
+{
+    ImagePublisher publisher;
+    std::atomic<bool> destroyed {false};
+
+    SECTION("Reader sees no image before publication")
+    {
+        ImagePublisher::ReadScope scope(publisher);
+        REQUIRE(scope.get() == nullptr);
+    }
+
+    SECTION("Reader sees the published snapshot with a fresh generation")
+    {
+        publisher.publish(makeSnapshot(destroyed));
+
+        ImagePublisher::ReadScope scope(publisher);
+        REQUIRE(scope.get() != nullptr);
+        REQUIRE(scope.get()->generation == 1);
+    }
+}
+
+//==============================================================================
+TEST_CASE("ImagePublisher defers reclamation while reading", "[publisher][rcu]")
+{
+    ImagePublisher publisher;
+    std::atomic<bool> firstDestroyed {false};
+    std::atomic<bool> secondDestroyed {false};
+
+    publisher.publish(makeSnapshot(firstDestroyed));
+
+    {
+        ImagePublisher::ReadScope scope(publisher);
+        const auto* firstSnapshot = scope.get();
+
+        // Swap while the reader still holds the first snapshot
+        publisher.publish(makeSnapshot(secondDestroyed));
+
+        REQUIRE_FALSE(waitFor(firstDestroyed, 200));
+        REQUIRE(firstSnapshot->loader->isLoaded());
+    }
+
+    // Once the read ends the retired snapshot is freed in the background
+    REQUIRE(waitFor(firstDestroyed, 1000));
+    REQUIRE_FALSE(secondDestroyed.load());
+}
@@ -0,0 +1,77 @@
+/*
+ * ImagePyramidTest.cpp - Unit tests for the prefiltered image pyramid
+ *
+ * Validates level dimensions, that uniform images stay uniform through both
+ * prefilters, and that trilinear sampling blends between adjacent levels.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "../../Source/ImagePyramid.h"
+#include "TestHelpers.h"
+
+#include <vector>
+
+using TestHelpers::TestPlanes;
+
+//==============================================================================
+TEST_CASE("ImagePyramid builds halving levels down to one pixel", "[pyramid]")
+{
+    TestPlanes planes(37, 10);
+
+    for (auto filter : {ImagePyramid::Filter::Box, ImagePyramid::Filter::Gaussian})
+    {
+        ImagePyramid pyramid;
+        REQUIRE(pyramid.build(planes.view, filter));
+
+        // 37x10 -> 19x5 -> 10x3 -> 5x2 -> 3x1 -> 2x1 -> 1x1
+        REQUIRE(pyramid.getNumLevels() == 7);
+        REQUIRE(pyramid.getLevel(1).width == 19);
+        REQUIRE(pyramid.getLevel(1).height == 5);
+        REQUIRE(pyramid.getLevel(6).width == 1);
+        REQUIRE(pyramid.getLevel(6).height == 1);
+    }
+}
+
+TEST_CASE("ImagePyramid preserves uniform colour on every level", "[pyramid]")
+{
+    TestPlanes planes(64, 48);
+    std::fill(planes.red.begin(), planes.red.end(), uint8_t {200});
+    std::fill(planes.green.begin(), planes.green.end(), uint8_t {100});
+    std::fill(planes.blue.begin(), planes.blue.end(), uint8_t {25});
+
+    ImagePyramid pyramid;
+    REQUIRE(pyramid.build(planes.view, ImagePyramid::Filter::Gaussian));
+
+    for (float lod : {0.0f, 0.5f, 1.0f, 2.7f, 6.0f})
+    {
+        const RGB value = pyramid.sample(31.0f, 17.0f, lod);
+        REQUIRE(value.red == 200);
+        REQUIRE(value.green == 100);
+        REQUIRE(value.blue == 25);
+    }
+}
+
+TEST_CASE("ImagePyramid blends between levels", "[pyramid]")
+{
+    // Vertical stripes average to mid grey after one box level
+    TestPlanes planes(8, 8);
+    for (int y = 0; y < 8; ++y)
+        for (int x = 0; x < 8; ++x)
+            planes.red[static_cast<size_t>(y * 8 + x)] = (x % 2 == 0) ? 0 : 254;
+
+    ImagePyramid pyramid;
+    REQUIRE(pyramid.build(planes.view, ImagePyramid::Filter::Box));
+
+    REQUIRE(pyramid.sample(2.0f, 2.0f, 0.0f).red == 0);
+    REQUIRE(pyramid.sample(2.0f, 2.0f, 1.0f).red == 127);
+    REQUIRE(pyramid.sample(2.0f, 2.0f, 0.5f).red == 64);
+}
+
+TEST_CASE("ImagePyramid honours cancellation", "[pyramid]")
+{
+    TestPlanes planes(16, 16);
+
+    ImagePyramid pyramid;
+    REQUIRE_FALSE(pyramid.build(planes.view, ImagePyramid::Filter::Gaussian, [] { return true; }));
+    REQUIRE(pyramid.getNumLevels() == 0);
+}
@@ -0,0 +1,185 @@
+/*
+ * ImpulseResponseBuilderTest.cpp - Unit tests for image-derived impulse responses
+ *
+ * Validates that a response has the requested length with the image's mean
+ * brightness removed and its tail faded to silence, that areas are averaged
+ * with the requested blur shape, that builds can be cancelled, and that the worker hands finished responses to the reader,
+ * waiting for deferred paths and asking for its start on the first request.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "../../Source/ImpulseResponseBuilder.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const Dimensions testDimensions {16, 4};
+
+    /**
+     * Loader whose pixels are a uniform grey, or a left-to-right ramp
+     */
+    class GradientLoader : public IImageLoader
+    {
+    public:
+        explicit GradientLoader(bool isGradient) : gradient(isGradient) {}
+
+        LoadResult loadImage(const std::string&, const LoadObserver& = {}) override { return LoadResult(true); }
+        RGB getPixel(float, float) const override { return {}; }
+        RGB getAreaAverage(float, float, int, BlurShape) const override { return {}; }
+
+        void getAreaAverages(const float* x, const float*, const float*, int numPositions,
+                             uint8_t* red, uint8_t* green, uint8_t* blue, BlurShape shape) const override
+        {
+            lastShape = shape;
+
+            for (int i = 0; i < numPositions; ++i)
+            {
+                const auto value = gradient ? static_cast<uint8_t>(x[i] * 255.0f / (testDimensions.width - 1))
+                                            : static_cast<uint8_t>(200);
+                red[i] = green[i] = blue[i] = value;
+            }
+        }
+
+        void setSampleCacheOptions(const SampleCacheOptions&) override {}
+        bool getAreaSamples(const float*, const float*, const float*, int,
+                            float*, ConversionFormula, BlurShape) const override { return false; }
+        bool isPyramidReady() const override { return false; }
+        const WavetableBank* getWavetables(WavetableAxis) const override { return nullptr; }
+        SpectrogramRenderer* getSpectrogram() const override { return nullptr; }
+        ImpulseResponseBuilder* getImpulseResponseBuilder() const override { return nullptr; }
+        Dimensions getDimensions() const override { return testDimensions; }
+        bool isLoaded() const override { return true; }
+        void clearImage() override {}
+        std::string getFilePath() const override { return {}; }
+        juce::Image getImage() const override { return {}; }
+        PixelPlanes getPixelPlanes() const override { return {}; }
+        bool isValidPosition(float, float) const override { return true; }
+
+        mutable BlurShape lastShape {BlurShape::Box};
+
+    private:
+        bool gradient;
+    };
+
+    ImpulseResponseSettings makeSettings(int lengthSamples, ScanPattern pattern = ScanPattern::Horizontal)
+    {
+        ImpulseResponseSettings settings;
+        settings.pattern = pattern;
+        settings.formula = ConversionFormula::RGBAverage;
+        settings.lengthSamples = lengthSamples;
+        return settings;
+    }
+
+    bool waitForResponse(ImpulseResponseBuilder& builder, juce::AudioBuffer<float>& destination)
+    {
+        for (int elapsed = 0; elapsed < 5000; elapsed += 10)
+        {
+            if (builder.takeImpulseResponse(destination))
+                return true;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        return false;
+    }
+}
+
+//==============================================================================
+TEST_CASE("ImpulseResponseBuilder reads a path into a shaped response", "[impulse]")
+{
+    ScanPath path;
+    path.compile(ScanPattern::Horizontal, testDimensions);
+
+    const ImpulseResponseSettings settings = makeSettings(1000);
+    std::vector<float> response(1000, 1.0f);
+
+    SECTION("A uniform image has no DC and renders silent")
+    {
+        GradientLoader loader(false);
+        REQUIRE(ImpulseResponseBuilder::render(loader, path, settings, response.data()));
+
+        for (float sample : response)
+            REQUIRE(sample == Catch::Approx(0.0f).margin(1e-5));
+    }
+
+    SECTION("A gradient follows the path and fades out at the end")
+    {
+        GradientLoader loader(true);
+        REQUIRE(ImpulseResponseBuilder::render(loader, path, settings, response.data()));
+
+        // Each row climbs from dark to bright, centred on zero
+        REQUIRE(response[0] < 0.0f);
+        REQUIRE(response[230] > 0.0f);
+        REQUIRE(response[999] == Catch::Approx(0.0f).margin(1e-6));
+    }
+
+    SECTION("Areas are averaged with the requested blur shape")
+    {
+        GradientLoader loader(true);
+        ImpulseResponseSettings gaussian = settings;
+        gaussian.blurShape = BlurShape::Gaussian;
+
+        REQUIRE(ImpulseResponseBuilder::render(loader, path, gaussian, response.data()));
+        REQUIRE(loader.lastShape == BlurShape::Gaussian);
+    }
+
+    SECTION("A cancelled build reports failure")
+    {
+        GradientLoader loader(true);
+        REQUIRE_FALSE(ImpulseResponseBuilder::render(loader, path, settings, response.data(), [] { return true; }));
+    }
+}
+
+//==============================================================================
+TEST_CASE("ImpulseResponseBuilder hands finished responses to the reader", "[impulse]")
+{
+    GradientLoader loader(true);
+    int firstRequests = 0;
+    ImpulseResponseBuilder builder(loader, [&firstRequests] { ++firstRequests; });
+    juce::AudioBuffer<float> destination;
+
+    SECTION("Compiled paths")
+    {
+        ScanPathSet paths;
+        paths.compile(testDimensions);
+        builder.setScanPaths(&paths);
+
+        REQUIRE_FALSE(builder.takeImpulseResponse(destination));
+
+        builder.request(makeSettings(4800));
+        REQUIRE(firstRequests == 1);
+
+        builder.startWorker();
+        REQUIRE(waitForResponse(builder, destination));
+        REQUIRE(destination.getNumChannels() == 1);
+        REQUIRE(destination.getNumSamples() == 4800);
+
+        // Repeating the same settings doesn't rebuild
+        builder.request(makeSettings(4800));
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        REQUIRE_FALSE(builder.takeImpulseResponse(destination));
+
+        builder.request(makeSettings(2400));
+        REQUIRE(firstRequests == 1);
+        builder.stopWorker();
+    }
+
+    SECTION("A deferred path is built before it is read")
+    {
+        ScanPathSet paths;
+        paths.compile(testDimensions, true);
+        builder.setScanPaths(&paths);
+
+        builder.startWorker();
+        builder.request(makeSettings(4800, ScanPattern::Hilbert));
+
+        REQUIRE(waitForResponse(builder, destination));
+        REQUIRE(paths.request(ScanPattern::Hilbert));
+        REQUIRE(destination.getNumSamples() == 4800);
+        builder.stopWorker();
+    }
+}
@@ -0,0 +1,289 @@
+/*
+ * NeedleBankTest.cpp - Unit tests for polyphonic scanning
+ *
+ * Validates that a single needle scans like IImageScanner, that needles are
+ * spread in phase, speed and pan, and that seeking matches continuous
+ * advancement for every needle.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "../../Source/NeedleBank.h"
+#include "../../Source/ImageScanner.h"
+
+#include <cmath>
+#include <vector>
+
+//==============================================================================
+TEST_CASE("NeedleBank with one needle matches the image scanner", "[needles]")
+{
+    ScanPathSet paths;
+    paths.compile(Dimensions(13, 7));
+
+    NeedleBank bank;
+    bank.prepare(256);
+    bank.initialize(paths);
+
+    auto scanner = createImageScanner();
+    scanner->initialize(paths);
+    scanner->setLooping(true);
+
+    std::vector<float> speeds(256), x(256), y(256);
+
+    for (int i = 0; i < 256; ++i)
+        speeds[static_cast<size_t>(i)] = 0.25f + static_cast<float>(i % 9) * 0.1f;
+
+    bank.advance(speeds.data(), 256);
+    bank.getPositions(0, x.data(), y.data(), 256);
+
+    for (int i = 0; i < 256; ++i)
+    {
+        const Position expected = scanner->advancePosition(speeds[static_cast<size_t>(i)]);
+        REQUIRE(x[static_cast<size_t>(i)] == Catch::Approx(expected.x).margin(1e-4));
+        REQUIRE(y[static_cast<size_t>(i)] == Catch::Approx(expected.y).margin(1e-4));
+    }
+
+    REQUIRE(bank.getGains(0).left == Catch::Approx(1.0f));
+    REQUIRE(bank.getGains(0).right == Catch::Approx(1.0f));
+}
+
+//==============================================================================
+TEST_CASE("NeedleBank spreads needles in phase, speed and pan", "[needles]")
+{
+    ScanPathSet paths;
+    paths.compile(Dimensions(9, 9));
+    const double length = paths.get(ScanPattern::Horizontal).getLength();
+
+    NeedleBank bank;
+    bank.prepare(64);
+    bank.initialize(paths);
+    bank.configure(4, 0.5f, 1.0f);
+
+    REQUIRE(bank.getNumNeedles() == 4);
+
+    SECTION("Needles start evenly spaced along the path")
+    {
+        for (int needle = 0; needle < 4; ++needle)
+            REQUIRE(bank.getPhase(needle) == Catch::Approx(length * needle / 4.0));
+    }
+
+    SECTION("Outer needles are detuned and panned symmetrically")
+    {
+        bank.advance(1.0f, 10);
+
+        REQUIRE(bank.getPhase(0) == Catch::Approx(5.0));
+        REQUIRE(bank.getPhase(3) == Catch::Approx(std::fmod(length * 0.75 + 15.0, length)));
+
+        // Hard left and hard right at full spread, normalised to the level of one needle
+        REQUIRE(bank.getGains(0).left == Catch::Approx(0.5f));
+        REQUIRE(bank.getGains(0).right == Catch::Approx(0.0f).margin(1e-6));
+        REQUIRE(bank.getGains(3).left == Catch::Approx(0.0f).margin(1e-6));
+        REQUIRE(bank.getGains(3).right == Catch::Approx(0.5f));
+    }
+
+    SECTION("Count is clamped to the bank size")
+    {
+        bank.configure(1000, 0.0f, 0.0f);
+        REQUIRE(bank.getNumNeedles() == NeedleBank::maxNeedles);
+    }
+}
+
+//==============================================================================
+TEST_CASE("NeedleBank seeking lands where continuous advancement would be", "[needles]")
+{
+    ScanPathSet paths;
+    paths.compile(Dimensions(17, 11));
+
+    for (auto pattern : {ScanPattern::Horizontal, ScanPattern::Spiral, ScanPattern::Hilbert})
+    {
+        NeedleBank running, seeking;
+
+        for (auto* bank : {&running, &seeking})
+        {
+            bank->prepare(128);
+            bank->setScanPattern(pattern);
+            bank->initialize(paths);
+            bank->configure(5, 0.3f, 0.5f);
+        }
+
+        running.advance(1.5f, 100);
+        seeking.setPhase(100 * 1.5);
+
+        for (int needle = 0; needle < 5; ++needle)
+            REQUIRE(seeking.getPhase(needle) == Catch::Approx(running.getPhase(needle)).margin(1e-6));
+    }
+}
+
+TEST_CASE("NeedleBank oscillator seeking lands where continuous playback would be", "[needles]")
+{
+    ScanPathSet paths;
+    paths.compile(Dimensions(17, 11));
+
+    NeedleBank bank;
+    bank.prepare(128);
+    bank.initialize(paths);
+    bank.configure(5, 0.3f, 0.5f);
+
+    // Each oscillator runs at cyclesPerSample scaled by its needle's detune
+    constexpr double cyclesPerSample = 0.013;
+    bank.setOscillatorPhases(1000 * cyclesPerSample);
+
+    std::vector<double> running(5);
+
+    for (int needle = 0; needle < 5; ++needle)
+        running[static_cast<size_t>(needle)] = bank.getOscillatorPhase(needle) + 250 * cyclesPerSample * bank.getSpeedScale(needle);
+
+    bank.setOscillatorPhases(1250 * cyclesPerSample);
+
+    for (int needle = 0; needle < 5; ++needle)
+    {
+        const double expected = running[static_cast<size_t>(needle)] - std::floor(running[static_cast<size_t>(needle)]);
+        REQUIRE(bank.getOscillatorPhase(needle) >= 0.0);
+        REQUIRE(bank.getOscillatorPhase(needle) < 1.0);
+        REQUIRE(bank.getOscillatorPhase(needle) == Catch::Approx(expected).margin(1e-9));
+    }
+}
+
+//==============================================================================
+TEST_CASE("NeedleBank voices come from a fixed pool", "[needles][midi]")
+{
+    ScanPathSet paths;
+    paths.compile(Dimensions(8, 8));
+    const double length = paths.get(ScanPattern::Horizontal).getLength();
+
+    NeedleBank bank;
+    bank.prepare(64);
+    bank.initialize(paths);
+    bank.setVoiceMode(true);
+
+    REQUIRE(bank.getNumNeedles() == 0);
+
+    SECTION("A voice runs one path length per cycle")
+    {
+        bank.startVoice(60, 0.01, 7.0f, 1.0f);
+        bank.advance(1.0f, 10);
+
+        REQUIRE(bank.getNumNeedles() == 1);
+        REQUIRE(bank.getPhase(0) == Catch::Approx(0.1 * length));
+        REQUIRE(bank.getAreaSize(0) == 7.0f);
+    }
+
+    SECTION("Stopping a voice keeps the sounding voices packed")
+    {
+        bank.startVoice(60, 0.01, 1.0f, 1.0f);
+        bank.startVoice(64, 0.02, 2.0f, 1.0f);
+        bank.startVoice(67, 0.03, 3.0f, 1.0f);
+        bank.stopVoice(60);
+
+        // Released voices are freed by the next advance once they have ramped out
+        REQUIRE(bank.getNumNeedles() == 3);
+        bank.advance(1.0f, 1);
+
+        REQUIRE(bank.getNumNeedles() == 2);
+        REQUIRE(bank.getNote(0) == 67);
+        REQUIRE(bank.getAreaSize(0) == 3.0f);
+        REQUIRE(bank.getNote(1) == 64);
+
+        // Unknown notes are ignored
+        bank.stopVoice(12);
+        bank.advance(1.0f, 1);
+        REQUIRE(bank.getNumNeedles() == 2);
+    }
+
+    SECTION("A full pool steals the oldest voice")
+    {
+        for (int note = 0; note < NeedleBank::maxNeedles; ++note)
+            bank.startVoice(note, 0.001, 1.0f, 1.0f);
+
+        bank.startVoice(100, 0.001, 1.0f, 1.0f);
+
+        REQUIRE(bank.getNumNeedles() == NeedleBank::maxNeedles);
+        REQUIRE(bank.getNote(0) == 100);
+    }
+
+    SECTION("Retriggering a sounding note restarts it in place")
+    {
+        bank.startVoice(60, 0.01, 1.0f, 1.0f);
+        bank.advance(1.0f, 10);
+        bank.startVoice(60, 0.01, 1.0f, 1.0f);
+
+        REQUIRE(bank.getNumNeedles() == 1);
+        REQUIRE(bank.getPhase(0) == 0.0);
+    }
+
+    SECTION("Unpitched voices scan at the common speed and keep their pitch")
+    {
+        bank.setPitchedScanning(false);
+        bank.startVoice(60, 0.01, 1.0f, 1.0f);
+        bank.advance(1.5f, 10);
+
+        REQUIRE(bank.getPhase(0) == Catch::Approx(15.0));
+        REQUIRE(bank.getVoiceRate(0) == 0.01);
+        REQUIRE(bank.getOscillatorPhase(0) == 0.0);
+
+        bank.setPitchedScanning(true);
+        REQUIRE(bank.getSpeedScale(0) == Catch::Approx(0.01 * length));
+    }
+}
+
+//==============================================================================
+TEST_CASE("NeedleBank voices ramp in and out", "[needles][midi]")
+{
+    ScanPathSet paths;
+    paths.compile(Dimensions(8, 8));
+
+    // 5 ms at 4 kHz is a 20 sample ramp
+    NeedleBank bank;
+    bank.prepare(64);
+    bank.setSampleRate(4000.0);
+    bank.initialize(paths);
+    bank.setVoiceMode(true);
+
+    const float fullLevel = NeedleBank::maxVoiceLevel * 0.5f;
+    bank.startVoice(60, 0.01, 1.0f, 0.5f);
+
+    SECTION("A new voice rises from silence to its velocity level")
+    {
+        bank.advance(1.0f, 10);
+        const float* envelope = bank.getEnvelope(0);
+
+        REQUIRE(envelope != nullptr);
+        REQUIRE(envelope[0] == Catch::Approx(fullLevel / 20.0f));
+        REQUIRE(envelope[9] == Catch::Approx(fullLevel * 0.5f));
+
+        // Once steady the level moves into the gains
+        bank.advance(1.0f, 10);
+        bank.advance(1.0f, 10);
+
+        REQUIRE(bank.getEnvelope(0) == nullptr);
+        REQUIRE(bank.getGains(0).left == Catch::Approx(fullLevel));
+        REQUIRE(bank.getGains(0).right == Catch::Approx(fullLevel));
+    }
+
+    SECTION("A released voice sounds until it has ramped out")
+    {
+        bank.advance(1.0f, 20);
+        bank.stopVoice(60);
+        bank.advance(1.0f, 10);
+
+        REQUIRE(bank.getNumNeedles() == 1);
+        REQUIRE(bank.getEnvelope(0)[9] == Catch::Approx(fullLevel * 0.5f));
+
+        bank.advance(1.0f, 10);
+        REQUIRE(bank.getNumNeedles() == 1);
+        REQUIRE(bank.getEnvelope(0)[9] == Catch::Approx(0.0f).margin(1e-6));
+
+        bank.advance(1.0f, 10);
+        REQUIRE(bank.getNumNeedles() == 0);
+    }
+
+    SECTION("Retriggering ramps from the current level")
+    {
+        bank.advance(1.0f, 10);
+        bank.startVoice(60, 0.01, 1.0f, 1.0f);
+        bank.advance(1.0f, 1);
+
+        REQUIRE(bank.getNumNeedles() == 1);
+        REQUIRE(bank.getEnvelope(0)[0] > fullLevel * 0.5f);
+    }
+}
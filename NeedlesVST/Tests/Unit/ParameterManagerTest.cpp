@@ -0,0 +1,180 @@
+/*
+ * ParameterManagerTest.cpp - Parameter snapshot tests
+ * 
+ * Validates the per-block parameter snapshot, its defaults and the change
+ * tracking used to decide when derived values must be recomputed.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "../../Source/ParameterManager.h"
+#include "../../Source/ParameterSmoother.h"
+
+#include <array>
+
+using Catch::Matchers::WithinAbs;
+
+namespace
+{
+    /**
+     * Minimal processor hosting the continuous parameters of the plugin layout
+     */
+    class TestProcessor : public juce::AudioProcessor
+    {
+    public:
+        TestProcessor() : parameters(*this, nullptr, "Parameters", createLayout()) {}
+        
+        static juce::AudioProcessorValueTreeState::ParameterLayout createLayout()
+        {
+            juce::AudioProcessorValueTreeState::ParameterLayout layout;
+            layout.add(std::make_unique<juce::AudioParameterFloat>(
+                "scanSpeed", "Scan Speed", juce::NormalisableRange<float>(0.1f, 10.0f, 0.01f), 1.0f));
+            layout.add(std::make_unique<juce::AudioParameterInt>("areaSize", "Area Size", 1, 50, 5));
+            layout.add(std::make_unique<juce::AudioParameterFloat>(
+                "outputGain", "Output Gain", juce::NormalisableRange<float>(0.0f, 2.0f, 0.01f), 1.0f));
+            
+            for (auto* id : { "redPan", "greenPan", "bluePan" })
+                layout.add(std::make_unique<juce::AudioParameterFloat>(
+                    id, id, juce::NormalisableRange<float>(-100.0f, 100.0f, 0.1f), 0.0f));
+            
+            return layout;
+        }
+        
+        const juce::String getName() const override { return "Test"; }
+        void prepareToPlay(double, int) override {}
+        void releaseResources() override {}
+        void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {}
+        double getTailLengthSeconds() const override { return 0.0; }
+        bool acceptsMidi() const override { return false; }
+        bool producesMidi() const override { return false; }
+        juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+        bool hasEditor() const override { return false; }
+        int getNumPrograms() override { return 1; }
+        int getCurrentProgram() override { return 0; }
+        void setCurrentProgram(int) override {}
+        const juce::String getProgramName(int) override { return {}; }
+        void changeProgramName(int, const juce::String&) override {}
+        void getStateInformation(juce::MemoryBlock&) override {}
+        void setStateInformation(const void*, int) override {}
+        
+        void setParameter(const juce::String& id, float value)
+        {
+            parameters.getParameter(id)->setValueNotifyingHost(parameters.getParameterRange(id).convertTo0to1(value));
+        }
+        
+        juce::AudioProcessorValueTreeState parameters;
+    };
+}
+
+//==============================================================================
+TEST_CASE("Parameter snapshot defaults match the parameter layout", "[parameter][snapshot]")
+{
+    auto paramManager = createParameterManager();
+    const auto& snapshot = paramManager->getSnapshot();
+    
+    REQUIRE_THAT(snapshot.scanSpeed, WithinAbs(1.0f, 0.0001f));
+    REQUIRE(snapshot.areaSize == 5);
+    REQUIRE_THAT(snapshot.outputGain, WithinAbs(1.0f, 0.0001f));
+    REQUIRE_THAT(snapshot.redPan, WithinAbs(0.0f, 0.0001f));
+    REQUIRE_THAT(snapshot.greenPan, WithinAbs(0.0f, 0.0001f));
+    REQUIRE_THAT(snapshot.bluePan, WithinAbs(0.0f, 0.0001f));
+    REQUIRE(snapshot.conversionFormula == ConversionFormula::RGBAverage);
+    REQUIRE(snapshot.scanPattern == ScanPattern::Horizontal);
+    REQUIRE(snapshot.transportSync == TransportSync::FreeRunning);
+    REQUIRE(snapshot.numNeedles == 1);
+    REQUIRE(snapshot.triggerMode == TriggerMode::FreeRunning);
+    REQUIRE(snapshot.oversampling == OversamplingFactor::Off);
+    REQUIRE(snapshot.synthesisMode == SynthesisMode::Scan);
+    REQUIRE(snapshot.wavetableFrequency == 110.0f);
+    REQUIRE(snapshot.spectrogramSpeed == 40.0f);
+    REQUIRE(snapshot.impulseLength == 1.5f);
+    REQUIRE(snapshot.convolutionMix == 100.0f);
+}
+
+//==============================================================================
+TEST_CASE("Parameter snapshot comparison", "[parameter][snapshot]")
+{
+    ParameterSnapshot a;
+    ParameterSnapshot b;
+    
+    SECTION("Identical snapshots compare equal")
+    {
+        REQUIRE(a == b);
+    }
+    
+    SECTION("Any differing value is detected")
+    {
+        b.bluePan = 25.0f;
+        REQUIRE(a != b);
+        
+        b = a;
+        b.conversionFormula = ConversionFormula::MaxChannel;
+        REQUIRE(a != b);
+        
+        b = a;
+        b.transportSync = TransportSync::HostBeats;
+        REQUIRE(a != b);
+    }
+}
+
+//==============================================================================
+TEST_CASE("Parameter change flag starts clear", "[parameter][snapshot]")
+{
+    auto paramManager = createParameterManager();
+    
+    REQUIRE_FALSE(paramManager->hasParametersChanged());
+}
+
+//==============================================================================
+TEST_CASE("Changing one parameter retargets only its smoother", "[parameter][snapshot][smoothing]")
+{
+    TestProcessor processor;
+    auto paramManager = createParameterManager();
+    ParameterSmoother smoother;
+    smoother.prepare(48000.0, 256);
+    
+    paramManager->updateFromValueTreeState(processor.parameters);
+    paramManager->hasParametersChanged();
+    smoother.reset(paramManager->getSnapshot());
+    
+    std::array<float, static_cast<size_t>(SmoothedParameter::NumParameters)> targets {};
+    for (size_t i = 0; i < targets.size(); ++i)
+        targets[i] = smoother.getTargetValue(static_cast<SmoothedParameter>(i));
+    
+    SECTION("An unchanged tree reports no change")
+    {
+        paramManager->updateFromValueTreeState(processor.parameters);
+        REQUIRE_FALSE(paramManager->hasParametersChanged());
+    }
+    
+    SECTION("A pan change moves only the pan target")
+    {
+        processor.setParameter("greenPan", 50.0f);
+        paramManager->updateFromValueTreeState(processor.parameters);
+        
+        REQUIRE(paramManager->hasParametersChanged());
+        REQUIRE_THAT(paramManager->getSnapshot().greenPan, WithinAbs(50.0f, 0.01f));
+        
+        smoother.setTargets(paramManager->getSnapshot());
+        smoother.process(256);
+        
+        for (size_t i = 0; i < targets.size(); ++i)
+        {
+            const auto parameter = static_cast<SmoothedParameter>(i);
+            
+            if (parameter == SmoothedParameter::GreenPan)
+            {
+                REQUIRE_THAT(smoother.getTargetValue(parameter), WithinAbs(50.0f, 0.01f));
+                REQUIRE(smoother.isSmoothing(parameter));
+            }
+            else
+            {
+                REQUIRE(smoother.getTargetValue(parameter) == targets[i]);
+                REQUIRE_FALSE(smoother.isSmoothing(parameter));
+            }
+        }
+        
+        // The change is only reported once
+        REQUIRE_FALSE(paramManager->hasParametersChanged());
+    }
+}
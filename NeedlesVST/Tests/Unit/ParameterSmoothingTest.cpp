@@ -0,0 +1,125 @@
+/*
+ * ParameterSmoothingTest.cpp - Parameter ramp tests
+ * 
+ * Validates that parameter changes ramp instead of jumping, that ramps finish
+ * within the 50 ms response time of SC-003, and that settled parameters are
+ * exposed as constant vectors.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "../../Source/ParameterSmoother.h"
+
+using Catch::Matchers::WithinAbs;
+
+namespace
+{
+    constexpr double testSampleRate = 48000.0;
+    constexpr int testBlockSize = 256;
+}
+
+//==============================================================================
+TEST_CASE("Settled parameters produce constant ramps", "[smoothing][parameter]")
+{
+    ParameterSmoother smoother;
+    smoother.prepare(testSampleRate, testBlockSize);
+    
+    ParameterSnapshot snapshot;
+    snapshot.scanSpeed = 2.5f;
+    smoother.reset(snapshot);
+    smoother.process(testBlockSize);
+    
+    REQUIRE_FALSE(smoother.isSmoothing(SmoothedParameter::ScanSpeed));
+    
+    const float* ramp = smoother.getRamp(SmoothedParameter::ScanSpeed);
+    for (int i = 0; i < testBlockSize; ++i)
+    {
+        REQUIRE_THAT(ramp[i], WithinAbs(2.5f, 0.0001f));
+    }
+}
+
+//==============================================================================
+TEST_CASE("Parameter changes ramp monotonically to the target", "[smoothing][parameter]")
+{
+    ParameterSmoother smoother;
+    smoother.prepare(testSampleRate, testBlockSize);
+    
+    ParameterSnapshot snapshot;
+    smoother.reset(snapshot);
+    
+    snapshot.redPan = 100.0f;
+    smoother.setTargets(snapshot);
+    
+    smoother.process(testBlockSize);
+    REQUIRE(smoother.isSmoothing(SmoothedParameter::RedPan));
+    
+    const float* ramp = smoother.getRamp(SmoothedParameter::RedPan);
+    
+    SECTION("No jump on the first sample")
+    {
+        REQUIRE(ramp[0] < 10.0f);
+    }
+    
+    SECTION("Ramp never moves away from the target")
+    {
+        for (int i = 1; i < testBlockSize; ++i)
+        {
+            REQUIRE(ramp[i] >= ramp[i - 1]);
+        }
+    }
+    
+    SECTION("Unchanged parameters stay constant")
+    {
+        REQUIRE_FALSE(smoother.isSmoothing(SmoothedParameter::GreenPan));
+    }
+}
+
+//==============================================================================
+TEST_CASE("Ramps complete within 50 ms", "[smoothing][parameter][SC-003]")
+{
+    ParameterSmoother smoother;
+    smoother.prepare(testSampleRate, testBlockSize);
+    
+    ParameterSnapshot snapshot;
+    smoother.reset(snapshot);
+    
+    snapshot.outputGain = 0.0f;
+    smoother.setTargets(snapshot);
+    
+    const int samplesIn50ms = static_cast<int>(testSampleRate * 0.05);
+    
+    for (int processed = 0; processed < samplesIn50ms; processed += testBlockSize)
+    {
+        smoother.process(testBlockSize);
+    }
+    
+    smoother.process(testBlockSize);
+    REQUIRE_FALSE(smoother.isSmoothing(SmoothedParameter::OutputGain));
+    REQUIRE_THAT(smoother.getRamp(SmoothedParameter::OutputGain)[0], WithinAbs(0.0f, 0.0001f));
+}
+
+//==============================================================================
+TEST_CASE("Rate changes keep ramps in progress", "[smoothing][parameter]")
+{
+    ParameterSmoother smoother;
+    smoother.prepare(testSampleRate, testBlockSize);
+    
+    ParameterSnapshot snapshot;
+    smoother.reset(snapshot);
+    
+    snapshot.redPan = 100.0f;
+    smoother.setTargets(snapshot);
+    smoother.process(testBlockSize);
+    
+    const float reached = smoother.getRamp(SmoothedParameter::RedPan)[testBlockSize - 1];
+    
+    smoother.setSampleRate(testSampleRate * 4.0);
+    smoother.process(testBlockSize);
+    
+    // Carries on from where it was, four times slower per sample, towards the same target
+    const float* ramp = smoother.getRamp(SmoothedParameter::RedPan);
+    REQUIRE(smoother.isSmoothing(SmoothedParameter::RedPan));
+    REQUIRE(ramp[0] > reached);
+    REQUIRE(ramp[0] - reached < 1.0f);
+    REQUIRE(ramp[testBlockSize - 1] < 100.0f);
+}
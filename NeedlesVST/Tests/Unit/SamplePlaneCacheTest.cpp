@@ -0,0 +1,169 @@
+/*
+ * SamplePlaneCacheTest.cpp - Unit tests for cached per-formula sample tables
+ *
+ * Validates that cached box averages match converting each pixel and
+ * averaging, that missing formulas are queued rather than built on the
+ * reading thread, and that the memory budget limits the slots with the least
+ * recently used formula recycled first.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "../../Source/SamplePlaneCache.h"
+#include "TestHelpers.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    using TestHelpers::TestPlanes;
+
+    // Deterministic pattern that differs between the channels
+    uint8_t patternPixel(size_t index, int channel)
+    {
+        switch (channel)
+        {
+            case 0:  return static_cast<uint8_t>((index * 37) & 0xff);
+            case 1:  return static_cast<uint8_t>((index * 91 + 13) & 0xff);
+            default: return static_cast<uint8_t>((255 - index * 7) & 0xff);
+        }
+    }
+
+    void fillPattern(TestPlanes& planes)
+    {
+        for (size_t i = 0; i < planes.red.size(); ++i)
+        {
+            planes.red[i] = patternPixel(i, 0);
+            planes.green[i] = patternPixel(i, 1);
+            planes.blue[i] = patternPixel(i, 2);
+        }
+    }
+
+    // Convert every pixel of the clipped window, then average
+    float expectedSample(const TestPlanes& planes, int centerX, int centerY, int areaSize, ConversionFormula formula)
+    {
+        const PixelPlanes& view = planes.view;
+        const ChannelWeights weights = getChannelWeights(formula);
+        double sum = 0.0;
+        int count = 0;
+
+        for (int y = centerY - areaSize / 2; y <= centerY + areaSize / 2; ++y)
+        {
+            for (int x = centerX - areaSize / 2; x <= centerX + areaSize / 2; ++x)
+            {
+                if (x < 0 || y < 0 || x >= view.width || y >= view.height)
+                    continue;
+
+                const size_t offset = view.offsetOf(x, y);
+                sum += weights.red * planes.red[offset] + weights.green * planes.green[offset]
+                     + weights.blue * planes.blue[offset];
+                ++count;
+            }
+        }
+
+        return static_cast<float>(sum / count / 255.0 * 2.0 - 1.0);
+    }
+
+    uint32_t formulaBit(ConversionFormula formula)
+    {
+        return 1u << static_cast<uint32_t>(formula);
+    }
+}
+
+//==============================================================================
+TEST_CASE("SamplePlaneCache box averages match per-pixel conversion", "[samplecache]")
+{
+    TestPlanes planes(23, 17);
+    fillPattern(planes);
+
+    SamplePlaneCache cache;
+    cache.prepare(planes.view, 64 * 1024 * 1024);
+
+    REQUIRE(cache.getNumSlots() == 5);
+
+    const std::vector<float> x {0.0f, 4.4f, 11.0f, 22.0f, 15.6f};
+    const std::vector<float> y {0.0f, 3.0f, 8.0f, 16.0f, 9.4f};
+    const std::vector<float> areaSizes {1.0f, 3.0f, 7.0f, 5.0f, 50.0f};
+    std::vector<float> output(x.size());
+
+    for (auto formula : {ConversionFormula::RGBAverage, ConversionFormula::WeightedRGB,
+                         ConversionFormula::RedChannel, ConversionFormula::BlueChannel})
+    {
+        REQUIRE(cache.build(formula));
+        REQUIRE(cache.getAreaSamples(x.data(), y.data(), areaSizes.data(), static_cast<int>(x.size()),
+                                     output.data(), formula));
+
+        for (size_t i = 0; i < x.size(); ++i)
+        {
+            const float expected = expectedSample(planes, static_cast<int>(std::round(x[i])),
+                                                  static_cast<int>(std::round(y[i])),
+                                                  static_cast<int>(areaSizes[i]) | 1, formula);
+            REQUIRE(output[i] == Catch::Approx(expected).margin(1e-4));
+        }
+    }
+}
+
+//==============================================================================
+TEST_CASE("SamplePlaneCache queues missing formulas for the builder", "[samplecache]")
+{
+    TestPlanes planes(8, 8);
+    fillPattern(planes);
+
+    SamplePlaneCache cache;
+    cache.prepare(planes.view, 64 * 1024 * 1024);
+
+    const float x = 2.0f, y = 2.0f, areaSize = 3.0f;
+    float output = 0.0f;
+
+    SECTION("A cacheable formula is requested and then served")
+    {
+        REQUIRE_FALSE(cache.getAreaSamples(&x, &y, &areaSize, 1, &output, ConversionFormula::WeightedRGB));
+
+        const uint32_t requested = cache.takeRequests();
+        REQUIRE(requested == formulaBit(ConversionFormula::WeightedRGB));
+        REQUIRE(cache.takeRequests() == 0);
+
+        REQUIRE(cache.build(ConversionFormula::WeightedRGB));
+        REQUIRE(cache.getAreaSamples(&x, &y, &areaSize, 1, &output, ConversionFormula::WeightedRGB));
+    }
+
+    SECTION("Nonlinear formulas are never cached")
+    {
+        REQUIRE_FALSE(SamplePlaneCache::isCacheable(ConversionFormula::MaxChannel));
+        REQUIRE_FALSE(cache.build(ConversionFormula::MinChannel));
+        REQUIRE_FALSE(cache.getAreaSamples(&x, &y, &areaSize, 1, &output, ConversionFormula::MaxChannel));
+        REQUIRE(cache.takeRequests() == 0);
+    }
+}
+
+//==============================================================================
+TEST_CASE("SamplePlaneCache recycles the least recently used slot", "[samplecache]")
+{
+    TestPlanes planes(16, 16);
+    fillPattern(planes);
+
+    SamplePlaneCache cache;
+    cache.prepare(planes.view, 0);
+    REQUIRE(cache.getNumSlots() == 0);
+
+    // 17 x 17 entries, rounded up to 8 x 8 tiles
+    const size_t tableBytes = 24 * 24 * sizeof(uint32_t);
+    cache.prepare(planes.view, 2 * tableBytes + tableBytes / 2);
+    REQUIRE(cache.getNumSlots() == 2);
+    REQUIRE(cache.getTableBytes() == tableBytes);
+
+    const float x = 8.0f, y = 8.0f, areaSize = 5.0f;
+    float output = 0.0f;
+
+    REQUIRE(cache.build(ConversionFormula::RedChannel));
+    REQUIRE(cache.build(ConversionFormula::GreenChannel));
+
+    // Reading red makes green the least recently used
+    REQUIRE(cache.getAreaSamples(&x, &y, &areaSize, 1, &output, ConversionFormula::RedChannel));
+    REQUIRE(cache.build(ConversionFormula::BlueChannel));
+
+    REQUIRE(cache.contains(ConversionFormula::RedChannel));
+    REQUIRE_FALSE(cache.contains(ConversionFormula::GreenChannel));
+    REQUIRE(cache.contains(ConversionFormula::BlueChannel));
+}
@@ -0,0 +1,345 @@
+/*
+ * ScanPathTest.cpp - Unit tests for compiled scan paths
+ *
+ * Validates the serpentine layouts, that random access by arc length matches
+ * sequential advancement, and that the scanner wraps and completes on the
+ * compiled path.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "../../Source/ScanPath.h"
+#include "../../Source/ImageScanner.h"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+//==============================================================================
+TEST_CASE("ScanPath compiles serpentine rows and columns", "[scanpath]")
+{
+    ScanPath horizontal;
+    horizontal.compile(ScanPattern::Horizontal, Dimensions(5, 3));
+
+    REQUIRE(horizontal.getNumSegments() == 3);
+    REQUIRE(horizontal.getLength() == Catch::Approx(12.0));
+
+    // Row 0 runs left to right, row 1 right to left
+    REQUIRE(horizontal.getPositionAt(2.5) == Position(2.5f, 0.0f));
+    REQUIRE(horizontal.getPositionAt(5.0) == Position(3.0f, 1.0f));
+    REQUIRE(horizontal.getPositionAt(8.0) == Position(0.0f, 2.0f));
+
+    ScanPath vertical;
+    vertical.compile(ScanPattern::Vertical, Dimensions(3, 5));
+
+    REQUIRE(vertical.getLength() == Catch::Approx(12.0));
+    REQUIRE(vertical.getPositionAt(1.0) == Position(0.0f, 1.0f));
+    REQUIRE(vertical.getPositionAt(5.0) == Position(1.0f, 3.0f));
+}
+
+TEST_CASE("ScanPath random access matches sequential lookups", "[scanpath]")
+{
+    ScanPath path;
+    path.compile(ScanPattern::Horizontal, Dimensions(97, 41));
+
+    int hint = -1;
+
+    for (double arc = 0.0; arc < path.getLength(); arc += 3.7)
+    {
+        REQUIRE(path.getPositionAt(arc, hint) == path.getPositionAt(arc));
+    }
+}
+
+TEST_CASE("ImageScanner follows the compiled path", "[scanpath][ImageScanner]")
+{
+    ScanPathSet paths;
+    paths.compile(Dimensions(4, 4));
+
+    auto scanner = createImageScanner();
+    scanner->initialize(paths);
+
+    SECTION("Looping wraps the phase")
+    {
+        const double length = scanner->getPathLength();
+        REQUIRE(length == Catch::Approx(12.0));
+
+        scanner->setPhase(length - 0.5);
+        scanner->advancePosition(1.0f);
+        REQUIRE(scanner->getPhase() == Catch::Approx(0.5));
+        REQUIRE(scanner->getCurrentPosition() == Position(0.5f, 0.0f));
+    }
+
+    SECTION("Non-looping scans complete at the end of the path")
+    {
+        scanner->setLooping(false);
+        scanner->setPhase(11.0);
+        scanner->advancePosition(2.0f);
+
+        REQUIRE(scanner->isComplete());
+        REQUIRE(scanner->getCurrentPosition() == Position(0.0f, 3.0f));
+    }
+
+    SECTION("Switching patterns restarts on the new path")
+    {
+        scanner->advancePosition(2.0f);
+        scanner->setScanPattern(ScanPattern::Vertical);
+        scanner->advancePosition(2.0f);
+
+        REQUIRE(scanner->getCurrentPosition() == Position(0.0f, 2.0f));
+    }
+
+    SECTION("Seeking lands where continuous playback would be")
+    {
+        // Transport-locked scans set the phase from the timeline every block
+        std::vector<float> x(40), y(40);
+        scanner->advancePositions(0.75f, x.data(), y.data(), 40);
+
+        auto seeking = createImageScanner();
+        seeking->initialize(paths);
+        seeking->setPhase(30 * 0.75);
+
+        std::vector<float> seekX(10), seekY(10);
+        seeking->advancePositions(0.75f, seekX.data(), seekY.data(), 10);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            REQUIRE(seekX[i] == Catch::Approx(x[30 + i]));
+            REQUIRE(seekY[i] == Catch::Approx(y[30 + i]));
+        }
+    }
+}
+
+TEST_CASE("ImageScanner batch advancement matches per-sample advancement", "[scanpath][ImageScanner]")
+{
+    ScanPathSet paths;
+    paths.compile(Dimensions(13, 7));
+
+    auto batch = createImageScanner();
+    auto single = createImageScanner();
+
+    for (auto pattern : {ScanPattern::Horizontal, ScanPattern::Vertical, ScanPattern::Diagonal, ScanPattern::Spiral,
+                         ScanPattern::Hilbert, ScanPattern::Morton})
+    {
+        for (bool looping : {true, false})
+        {
+            batch->setScanPattern(pattern);
+            single->setScanPattern(pattern);
+            batch->setLooping(looping);
+            single->setLooping(looping);
+            batch->initialize(paths);
+            single->initialize(paths);
+
+            // Enough samples to cross many rows and wrap the loop several times
+            constexpr int numSamples = 700;
+            std::vector<float> speeds(numSamples), x(numSamples), y(numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                speeds[i] = 0.1f + static_cast<float>(i % 50) * 0.05f;
+
+            batch->advancePositions(speeds.data(), x.data(), y.data(), numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const Position expected = single->advancePosition(speeds[i]);
+                REQUIRE(Position(x[i], y[i]) == expected);
+            }
+
+            REQUIRE(batch->isComplete() == single->isComplete());
+            REQUIRE(batch->getPhase() == Catch::Approx(single->getPhase()));
+        }
+    }
+}
+
+TEST_CASE("ScanPath evaluates diagonal and spiral paths in closed form", "[scanpath]")
+{
+    const Dimensions dimensions(9, 5);
+
+    SECTION("Diagonal zigzags along the anti-diagonals")
+    {
+        ScanPath diagonal;
+        diagonal.compile(ScanPattern::Diagonal, dimensions);
+
+        const double root2 = std::sqrt(2.0);
+
+        // 45 pixels on 13 diagonals: 32 diagonal steps and 12 edge steps
+        REQUIRE(diagonal.getLength() == Catch::Approx(32.0 * root2 + 12.0));
+        REQUIRE(diagonal.getPositionAt(0.0) == Position(0.0f, 0.0f));
+        REQUIRE(diagonal.getPositionAt(1.0) == Position(1.0f, 0.0f));
+        REQUIRE(diagonal.getPositionAt(1.0 + root2) == Position(0.0f, 1.0f));
+        REQUIRE(diagonal.getPositionAt(2.0 + root2) == Position(0.0f, 2.0f));
+        REQUIRE(diagonal.getPositionAt(2.0 + 3.0 * root2) == Position(2.0f, 0.0f));
+        REQUIRE(diagonal.getPositionAt(diagonal.getLength()) == Position(8.0f, 4.0f));
+    }
+
+    SECTION("Spiral starts at the centre and stays inside the image")
+    {
+        ScanPath spiral;
+        spiral.compile(ScanPattern::Spiral, dimensions);
+
+        REQUIRE(spiral.getPositionAt(0.0) == Position(4.0f, 2.0f));
+
+        for (double arc = 0.0; arc <= spiral.getLength(); arc += 0.25)
+        {
+            const Position position = spiral.getPositionAt(arc);
+            REQUIRE(position.x >= 0.0f);
+            REQUIRE(position.x <= 8.0f);
+            REQUIRE(position.y >= 0.0f);
+            REQUIRE(position.y <= 4.0f);
+        }
+
+        // Ends on the outer edge of the inscribed ellipse
+        const Position end = spiral.getPositionAt(spiral.getLength());
+        REQUIRE(end == Position(8.0f, 2.0f));
+    }
+
+    SECTION("Random access needs no prior advancement")
+    {
+        ScanPath spiral;
+        spiral.compile(ScanPattern::Spiral, Dimensions(256, 256));
+
+        int hint = -1;
+        float x = 0.0f, y = 0.0f;
+        const double arc = 12345.678;
+        spiral.getPositions(&arc, &x, &y, 1, hint);
+
+        REQUIRE(Position(x, y) == spiral.getPositionAt(arc));
+    }
+}
+
+//==============================================================================
+TEST_CASE("ScanPath space-filling curves visit every pixel once", "[scanpath]")
+{
+    for (auto pattern : {ScanPattern::Hilbert, ScanPattern::Morton})
+    {
+        for (auto dimensions : {Dimensions(16, 16), Dimensions(13, 7), Dimensions(1, 5)})
+        {
+            ScanPath path;
+            path.compile(pattern, dimensions);
+
+            const int numPixels = dimensions.width * dimensions.height;
+            REQUIRE(path.getLength() == Catch::Approx(static_cast<double>(numPixels)));
+
+            std::vector<int> visits(static_cast<size_t>(numPixels), 0);
+
+            for (int step = 0; step < numPixels; ++step)
+            {
+                const Position position = path.getPositionAt(static_cast<double>(step));
+                const int x = static_cast<int>(position.x);
+                const int y = static_cast<int>(position.y);
+
+                REQUIRE(x >= 0);
+                REQUIRE(x < dimensions.width);
+                REQUIRE(y >= 0);
+                REQUIRE(y < dimensions.height);
+                ++visits[static_cast<size_t>(y * dimensions.width + x)];
+            }
+
+            for (int count : visits)
+                REQUIRE(count == 1);
+        }
+    }
+}
+
+TEST_CASE("ScanPath diagonal raster covers every pixel", "[scanpath]")
+{
+    // A square image used to retrace a single diagonal
+    for (auto dimensions : {Dimensions(32, 32), Dimensions(9, 5), Dimensions(3, 11), Dimensions(1, 6)})
+    {
+        ScanPath path;
+        path.compile(ScanPattern::Diagonal, dimensions);
+
+        const int numPixels = dimensions.width * dimensions.height;
+        const int numDiagonals = dimensions.width + dimensions.height - 1;
+        const double expectedLength = std::sqrt(2.0) * (numPixels - numDiagonals) + (numDiagonals - 1);
+        REQUIRE(path.getLength() == Catch::Approx(expectedLength));
+
+        std::vector<int> visits(static_cast<size_t>(numPixels), 0);
+        Position previous = path.getPositionAt(0.0);
+        const double step = 0.125;
+
+        for (double arc = 0.0; arc <= path.getLength(); arc += step)
+        {
+            const Position position = path.getPositionAt(arc);
+
+            // Continuous: no jumps between consecutive lookups
+            REQUIRE(std::abs(position.x - previous.x) <= step + 1.0e-3);
+            REQUIRE(std::abs(position.y - previous.y) <= step + 1.0e-3);
+            previous = position;
+
+            const float nearestX = std::round(position.x);
+            const float nearestY = std::round(position.y);
+
+            // Passing within a step of the pixel centre counts as a visit
+            if (std::abs(position.x - nearestX) < 0.1f && std::abs(position.y - nearestY) < 0.1f)
+                ++visits[static_cast<size_t>(nearestY * dimensions.width + nearestX)];
+        }
+
+        for (int count : visits)
+            REQUIRE(count > 0);
+    }
+}
+
+TEST_CASE("ScanPath Hilbert curve steps between neighbouring pixels", "[scanpath]")
+{
+    ScanPath path;
+    path.compile(ScanPattern::Hilbert, Dimensions(32, 32));
+
+    for (int step = 0; step + 1 < 32 * 32; ++step)
+    {
+        const Position from = path.getPositionAt(static_cast<double>(step));
+        const Position to = path.getPositionAt(static_cast<double>(step + 1));
+        REQUIRE(std::abs(to.x - from.x) + std::abs(to.y - from.y) == Catch::Approx(1.0f));
+
+        // Halfway between pixels the position glides along the step
+        const Position middle = path.getPositionAt(step + 0.5);
+        REQUIRE(middle.x == Catch::Approx(0.5f * (from.x + to.x)));
+        REQUIRE(middle.y == Catch::Approx(0.5f * (from.y + to.y)));
+    }
+}
+
+TEST_CASE("ScanPath Morton curve follows the Z order", "[scanpath]")
+{
+    ScanPath path;
+    path.compile(ScanPattern::Morton, Dimensions(4, 4));
+
+    const float expectedX[] = {0, 1, 0, 1, 2, 3, 2, 3};
+    const float expectedY[] = {0, 0, 1, 1, 0, 0, 1, 1};
+
+    for (int step = 0; step < 8; ++step)
+    {
+        const Position position = path.getPositionAt(static_cast<double>(step));
+        REQUIRE(position.x == expectedX[step]);
+        REQUIRE(position.y == expectedY[step]);
+    }
+
+    // Diagonal jumps inside the Z are not interpolated
+    const Position jump = path.getPositionAt(1.5);
+    REQUIRE(jump.x == 1.0f);
+    REQUIRE(jump.y == 0.0f);
+}
+
+TEST_CASE("ScanPathSet builds deferred tables once requested", "[scanpath]")
+{
+    const Dimensions dimensions(64, 48);
+
+    ScanPathSet paths;
+    paths.compile(dimensions, true);
+
+    // Morton needs no table and stands in for Hilbert until it is built
+    REQUIRE(paths.get(ScanPattern::Morton).getLength() == Catch::Approx(64.0 * 48.0));
+    REQUIRE(paths.get(ScanPattern::Hilbert).getPattern() == ScanPattern::Morton);
+    REQUIRE(paths.request(ScanPattern::Spiral));
+
+    bool ready = paths.request(ScanPattern::Hilbert);
+
+    for (int elapsed = 0; elapsed < 5000 && !ready; elapsed += 10)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ready = paths.request(ScanPattern::Hilbert);
+    }
+
+    REQUIRE(ready);
+    REQUIRE(paths.get(ScanPattern::Hilbert).getPattern() == ScanPattern::Hilbert);
+    REQUIRE(paths.get(ScanPattern::Hilbert).getLength() == Catch::Approx(64.0 * 48.0));
+}
@@ -0,0 +1,156 @@
+/*
+ * SpectrogramRendererTest.cpp - Unit tests for inverse-FFT spectrogram playback
+ *
+ * Validates that a lit row resynthesises to a steady sinusoid at its bin's
+ * frequency, that dark images are silent, and that the worker renders only a
+ * bounded lead ahead of the reader, with underruns read as silence, and that
+ * samples rendered before a flush or a rate change are never played.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "../../Source/SpectrogramRenderer.h"
+#include "TestHelpers.h"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr double twoPi = 6.283185307179586;
+
+    using TestHelpers::TestPlanes;
+
+    // Black image with one white row, or none when litRow is negative
+    auto litRowPixel(int litRow)
+    {
+        return [litRow](int, int y, int) { return static_cast<uint8_t>(y == litRow ? 255 : 0); };
+    }
+}
+
+//==============================================================================
+TEST_CASE("SpectrogramRenderer plays a lit row as a steady sinusoid", "[spectrogram]")
+{
+    // One row per bin, so row numBins - k is exactly bin k
+    constexpr int bin = 64;
+    TestPlanes planes(4, SpectrogramRenderer::numBins + 1, litRowPixel(SpectrogramRenderer::numBins - bin));
+
+    SpectrogramRenderer renderer;
+    renderer.prepare(planes.view);
+    renderer.setSettings({44100.0, 10.0f, ConversionFormula::WeightedRGB});
+
+    REQUIRE(renderer.renderAhead() > 0);
+
+    std::vector<float> output(SpectrogramRenderer::leadSamples);
+    REQUIRE(renderer.read(output.data(), static_cast<int>(output.size())) == static_cast<int>(output.size()));
+
+    // Past the fade-in of the first frames, every window overlaps fully
+    const int settled = SpectrogramRenderer::frameSize;
+    const int length = static_cast<int>(output.size()) - settled;
+    const double frequency = static_cast<double>(bin) / SpectrogramRenderer::frameSize;
+
+    double real = 0.0, imaginary = 0.0, peak = 0.0;
+
+    for (int i = 0; i < length; ++i)
+    {
+        const double sample = output[static_cast<size_t>(settled + i)];
+        real += sample * std::cos(twoPi * frequency * i);
+        imaginary += sample * std::sin(twoPi * frequency * i);
+        peak = std::max(peak, std::abs(sample));
+    }
+
+    const double amplitude = 2.0 * std::sqrt(real * real + imaginary * imaginary) / length;
+
+    REQUIRE(amplitude == Catch::Approx(SpectrogramRenderer::getBinAmplitude()).epsilon(0.01));
+    REQUIRE(peak == Catch::Approx(SpectrogramRenderer::getBinAmplitude()).epsilon(0.01));
+}
+
+//==============================================================================
+TEST_CASE("SpectrogramRenderer keeps a bounded lead over the reader", "[spectrogram]")
+{
+    TestPlanes planes(8, 32, litRowPixel(-1));
+
+    SpectrogramRenderer renderer;
+    std::vector<float> output(1024, 1.0f);
+
+    SECTION("Nothing rendered reads as silence")
+    {
+        renderer.prepare(planes.view);
+
+        REQUIRE(renderer.read(output.data(), 1024) == 0);
+        REQUIRE(output[0] == 0.0f);
+        REQUIRE(output[1023] == 0.0f);
+    }
+
+    SECTION("The worker stops at the lead and resumes as samples are read")
+    {
+        renderer.prepare(planes.view);
+
+        const int framesToLead = SpectrogramRenderer::leadSamples / SpectrogramRenderer::hopSize;
+        REQUIRE(renderer.renderAhead() == framesToLead);
+        REQUIRE(renderer.renderAhead() == 0);
+
+        REQUIRE(renderer.read(output.data(), 1024) == 1024);
+        REQUIRE(renderer.renderAhead() == 1024 / SpectrogramRenderer::hopSize);
+
+        // A dark image is silent
+        for (float sample : output)
+            REQUIRE(sample == 0.0f);
+    }
+
+    SECTION("The playhead advances by the column speed and loops")
+    {
+        renderer.prepare(planes.view);
+        renderer.setSettings({SpectrogramRenderer::hopSize * 10.0, 5.0f, ConversionFormula::RGBAverage});
+
+        // Half a column per hop, 16 hops = 8 columns = one loop
+        renderer.renderAhead();
+        REQUIRE(renderer.getPlayhead() == Catch::Approx(0.0).margin(1e-9));
+    }
+}
+
+//==============================================================================
+TEST_CASE("SpectrogramRenderer drops samples rendered before a flush", "[spectrogram]")
+{
+    TestPlanes planes(8, 32, litRowPixel(16));
+
+    SpectrogramRenderer renderer;
+    renderer.prepare(planes.view);
+    renderer.setSettings({44100.0, 10.0f, ConversionFormula::WeightedRGB});
+    renderer.startWorker();
+
+    std::vector<float> output(1024, 1.0f);
+
+    const auto waitForSamples = [&renderer, &output]
+    {
+        for (int attempt = 0; attempt < 500; ++attempt)
+        {
+            if (renderer.read(output.data(), 1) == 1)
+                return true;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+
+        return false;
+    };
+
+    REQUIRE(waitForSamples());
+
+    SECTION("Leaving the mode")
+    {
+        renderer.flush();
+    }
+
+    SECTION("Changing the rate")
+    {
+        renderer.setSettings({88200.0, 10.0f, ConversionFormula::WeightedRGB});
+    }
+
+    // Silent until the worker has emptied the buffer, then only new samples
+    REQUIRE(renderer.read(output.data(), 1024) < 1024);
+    REQUIRE(waitForSamples());
+
+    renderer.stopWorker();
+}
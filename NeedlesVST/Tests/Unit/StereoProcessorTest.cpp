@@ -9,6 +9,10 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include "../../Source/StereoProcessor.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 using Catch::Matchers::WithinAbs;
 
 //==============================================================================
@@ -137,4 +141,139 @@ TEST_CASE("RGB Channel Processing", "[stereo][rgb][channels]")
         REQUIRE(right >= -1.0f);
         REQUIRE(right <= 1.0f);
     }
+    
+    SECTION("Cached gains follow a pan change")
+    {
+        auto [leftBefore, rightBefore] = processor->processRGBChannels(1.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f);
+        auto [leftAfter, rightAfter] = processor->processRGBChannels(1.0f, 0.0f, 0.0f, +1.0f, 0.0f, 0.0f);
+        
+        REQUIRE_THAT(leftBefore, WithinAbs(1.0f, 0.0001f));
+        REQUIRE_THAT(rightBefore, WithinAbs(0.0f, 0.0001f));
+        REQUIRE_THAT(leftAfter, WithinAbs(0.0f, 0.0001f));
+        REQUIRE_THAT(rightAfter, WithinAbs(1.0f, 0.0001f));
+    }
+}
+
+//==============================================================================
+TEST_CASE("Pan Gain Ramps", "[stereo][panning][ramp]")
+{
+    auto processor = createStereoProcessor();
+    
+    constexpr int numSamples = 2001;
+    std::vector<float> pans(numSamples), left(numSamples), right(numSamples);
+    
+    for (int i = 0; i < numSamples; ++i)
+        pans[static_cast<size_t>(i)] = -1.0f + 2.0f * static_cast<float>(i) / (numSamples - 1);
+    
+    SECTION("Approximated gains stay within the error bound of the sin/cos law")
+    {
+        processor->computePanGains(pans.data(), left.data(), right.data(), numSamples);
+        
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto [exactLeft, exactRight] = processor->processPan(1.0f, pans[static_cast<size_t>(i)]);
+            
+            REQUIRE_THAT(left[static_cast<size_t>(i)], WithinAbs(exactLeft, StereoProcessor::maxFastGainError));
+            REQUIRE_THAT(right[static_cast<size_t>(i)], WithinAbs(exactRight, StereoProcessor::maxFastGainError));
+        }
+        
+        // Hard pans silence the far side exactly
+        REQUIRE(right.front() == 0.0f);
+        REQUIRE(left.back() == 0.0f);
+    }
+    
+    SECTION("Gains can be written over the pan positions")
+    {
+        std::vector<float> expectedLeft(numSamples);
+        processor->computePanGains(pans.data(), expectedLeft.data(), right.data(), numSamples);
+        processor->computePanGains(pans.data(), pans.data(), right.data(), numSamples);
+        
+        REQUIRE(pans == expectedLeft);
+    }
+}
+
+//==============================================================================
+TEST_CASE("RGB Block Processing", "[stereo][rgb][block]")
+{
+    StereoProcessor processor;
+    
+    // Several passes, the last one partial
+    constexpr int numSamples = 2 * StereoProcessor::mixChunkSize + 37;
+    std::vector<float> red(numSamples), green(numSamples), blue(numSamples);
+    std::vector<float> outputGain(numSamples, 1.0f);
+    std::vector<float> left(numSamples, 0.0f), right(numSamples, 0.0f);
+    
+    for (int i = 0; i < numSamples; ++i)
+    {
+        red[static_cast<size_t>(i)] = std::sin(0.1f * static_cast<float>(i));
+        green[static_cast<size_t>(i)] = 0.5f;
+        blue[static_cast<size_t>(i)] = -0.25f;
+    }
+    
+    RGBPanGains gains;
+    gains.redLeft = 1.0f;
+    gains.greenLeft = 0.7071f;
+    gains.greenRight = 0.7071f;
+    gains.blueRight = 1.0f;
+    
+    SECTION("Channels are panned, normalised and added to the output")
+    {
+        std::fill(left.begin(), left.end(), 0.25f);
+        processor.processRGBBlock(red.data(), green.data(), blue.data(), gains, outputGain.data(),
+                                  left.data(), right.data(), numSamples);
+        
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto index = static_cast<size_t>(i);
+            const float expectedLeft = (red[index] + green[index] * 0.7071f) / 3.0f;
+            const float expectedRight = (green[index] * 0.7071f + blue[index]) / 3.0f;
+            
+            REQUIRE_THAT(left[index], WithinAbs(0.25f + expectedLeft, 0.0001f));
+            REQUIRE_THAT(right[index], WithinAbs(expectedRight, 0.0001f));
+        }
+    }
+    
+    SECTION("Each block's mix is clamped after the output gain")
+    {
+        std::fill(red.begin(), red.end(), 1.0f);
+        std::fill(outputGain.begin(), outputGain.end(), 10.0f);
+        processor.processRGBBlock(red.data(), green.data(), blue.data(), gains, outputGain.data(),
+                                  left.data(), nullptr, numSamples);
+        
+        for (float sample : left)
+            REQUIRE(sample == 1.0f);
+    }
+    
+    SECTION("Steady ramps match constant gains")
+    {
+        std::vector<float> redLeft(numSamples, gains.redLeft), redRight(numSamples, gains.redRight);
+        std::vector<float> greenLeft(numSamples, gains.greenLeft), greenRight(numSamples, gains.greenRight);
+        std::vector<float> blueLeft(numSamples, gains.blueLeft), blueRight(numSamples, gains.blueRight);
+        
+        RGBPanGainRamps ramps;
+        ramps.redLeft = redLeft.data();
+        ramps.redRight = redRight.data();
+        ramps.greenLeft = greenLeft.data();
+        ramps.greenRight = greenRight.data();
+        ramps.blueLeft = blueLeft.data();
+        ramps.blueRight = blueRight.data();
+        ramps.leftScale = 0.5f;
+        
+        std::vector<float> expectedLeft(numSamples, 0.0f), expectedRight(numSamples, 0.0f);
+        RGBPanGains scaledGains = gains;
+        scaledGains.redLeft *= 0.5f;
+        scaledGains.greenLeft *= 0.5f;
+        scaledGains.blueLeft *= 0.5f;
+        
+        processor.processRGBBlock(red.data(), green.data(), blue.data(), scaledGains, outputGain.data(),
+                                  expectedLeft.data(), expectedRight.data(), numSamples);
+        processor.processRGBBlock(red.data(), green.data(), blue.data(), ramps, outputGain.data(),
+                                  left.data(), right.data(), numSamples);
+        
+        for (int i = 0; i < numSamples; ++i)
+        {
+            REQUIRE_THAT(left[static_cast<size_t>(i)], WithinAbs(expectedLeft[static_cast<size_t>(i)], 1.0e-6f));
+            REQUIRE_THAT(right[static_cast<size_t>(i)], WithinAbs(expectedRight[static_cast<size_t>(i)], 1.0e-6f));
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,181 @@
+/*
+ * WavetableBankTest.cpp - Unit tests for image scanline wavetables
+ *
+ * Validates that a row or column is played back as one cycle with its DC
+ * offset removed, that every mip level is band-limited to its harmonic count,
+ * that the level follows the oscillator frequency, and that scan positions
+ * morph between neighbouring tables.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "../../Source/WavetableBank.h"
+#include "TestHelpers.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    constexpr double twoPi = 6.283185307179586;
+
+    using TestHelpers::TestPlanes;
+
+    uint8_t sinePixel(int index, int length, int harmonic)
+    {
+        const double value = std::sin(twoPi * harmonic * index / length);
+        return static_cast<uint8_t>(std::lround(127.5 + 127.0 * value));
+    }
+
+    // Magnitude of one harmonic of a stored cycle, normalised to a unit sine
+    double harmonicMagnitude(const float* cycle, int length, int harmonic)
+    {
+        double real = 0.0, imaginary = 0.0;
+
+        for (int i = 0; i < length; ++i)
+        {
+            real += cycle[i] * std::cos(twoPi * harmonic * i / length);
+            imaginary += cycle[i] * std::sin(twoPi * harmonic * i / length);
+        }
+
+        return 2.0 * std::sqrt(real * real + imaginary * imaginary) / length;
+    }
+}
+
+//==============================================================================
+TEST_CASE("WavetableBank plays each row as one cycle without its offset", "[wavetable]")
+{
+    // Red is one sine cycle per row, green is flat, blue is the sine's second harmonic
+    TestPlanes planes(256, 4, [](int x, int, int channel)
+    {
+        return channel == 0 ? sinePixel(x, 256, 1)
+             : channel == 1 ? static_cast<uint8_t>(200)
+                            : sinePixel(x, 256, 2);
+    });
+
+    WavetableBank bank;
+    REQUIRE(bank.build(planes.view, WavetableAxis::Rows));
+    REQUIRE(bank.getNumTables() == 4);
+    REQUIRE(bank.getNumLines() == 4);
+
+    const int numSamples = 512;
+    const double cyclesPerSample = 1.0 / numSamples;
+    std::vector<float> positions(numSamples, 1.0f), red(numSamples), green(numSamples), blue(numSamples);
+
+    double phase = 0.0;
+    bank.render(positions.data(), phase, cyclesPerSample, red.data(), green.data(), blue.data(), numSamples);
+
+    REQUIRE(phase == Catch::Approx(0.0).margin(1e-9));
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const double angle = twoPi * i / numSamples;
+        REQUIRE(red[static_cast<size_t>(i)] == Catch::Approx(std::sin(angle) * 127.0 / 127.5).margin(0.02));
+        REQUIRE(green[static_cast<size_t>(i)] == Catch::Approx(0.0f).margin(1e-4));
+        REQUIRE(blue[static_cast<size_t>(i)] == Catch::Approx(std::sin(2.0 * angle) * 127.0 / 127.5).margin(0.02));
+    }
+}
+
+//==============================================================================
+TEST_CASE("WavetableBank mip levels are band-limited", "[wavetable]")
+{
+    // A square wave has harmonics all the way up
+    TestPlanes planes(1024, 1, [](int x, int, int) { return static_cast<uint8_t>(x < 512 ? 255 : 0); });
+
+    WavetableBank bank;
+    REQUIRE(bank.build(planes.view, WavetableAxis::Rows));
+
+    for (int level = 0; level < WavetableBank::numLevels; ++level)
+    {
+        const float* cycle = bank.getCycle(0, 0, level);
+        const int length = WavetableBank::getLevelSize(level);
+        const int maxHarmonics = WavetableBank::getMaxHarmonics(level);
+
+        REQUIRE(cycle[length] == cycle[0]);
+        REQUIRE(harmonicMagnitude(cycle, length, 1) == Catch::Approx(4.0 / (twoPi / 2.0)).margin(0.02));
+
+        for (int harmonic = maxHarmonics + 1; harmonic < length / 2; harmonic += 7)
+        {
+            REQUIRE(harmonicMagnitude(cycle, length, harmonic) < 1e-3);
+        }
+    }
+}
+
+//==============================================================================
+TEST_CASE("WavetableBank picks the level that stays below Nyquist", "[wavetable]")
+{
+    REQUIRE(WavetableBank::getLevelForFrequency(0.0) == 0);
+    REQUIRE(WavetableBank::getLevelForFrequency(1.0 / 1024.0) == 0);
+    REQUIRE(WavetableBank::getLevelForFrequency(1.0 / 1000.0) == 1);
+    REQUIRE(WavetableBank::getLevelForFrequency(440.0 / 44100.0) == 4);
+    REQUIRE(WavetableBank::getLevelForFrequency(-440.0 / 44100.0) == 4);
+    REQUIRE(WavetableBank::getLevelForFrequency(0.4) == WavetableBank::numLevels - 1);
+
+    for (int level = 0; level < WavetableBank::numLevels; ++level)
+    {
+        REQUIRE(WavetableBank::getMaxHarmonics(level) * 2 < WavetableBank::getLevelSize(level));
+    }
+}
+
+//==============================================================================
+TEST_CASE("WavetableBank morphs between neighbouring tables", "[wavetable]")
+{
+    // Column 0 is a sine, column 4 its inverse; tables are taken every other column
+    TestPlanes planes(5, 128, [](int x, int y, int)
+    {
+        const uint8_t value = sinePixel(y, 128, 1);
+        return x < 2 ? value : (x > 2 ? static_cast<uint8_t>(255 - value) : static_cast<uint8_t>(128));
+    });
+
+    WavetableBank bank;
+    REQUIRE(bank.build(planes.view, WavetableAxis::Columns));
+    REQUIRE(bank.getAxis() == WavetableAxis::Columns);
+    REQUIRE(bank.getNumTables() == 5);
+
+    const int numSamples = 64;
+    std::vector<float> red(numSamples), green(numSamples), blue(numSamples);
+
+    auto renderAt = [&](float position)
+    {
+        std::vector<float> positions(numSamples, position);
+        double phase = 0.25;
+        bank.render(positions.data(), phase, 0.0, red.data(), green.data(), blue.data(), numSamples);
+        return red[0];
+    };
+
+    const float first = renderAt(0.0f);
+    const float last = renderAt(4.0f);
+
+    REQUIRE(first == Catch::Approx(127.0 / 127.5).margin(0.02));
+    REQUIRE(last == Catch::Approx(-first).margin(0.02));
+    REQUIRE(renderAt(0.5f) == Catch::Approx(first).margin(1e-4));
+    REQUIRE(renderAt(1.5f) == Catch::Approx(0.5f * first).margin(0.02));
+    REQUIRE(renderAt(-10.0f) == Catch::Approx(first).margin(1e-4));
+    REQUIRE(renderAt(10.0f) == Catch::Approx(last).margin(1e-4));
+}
+
+//==============================================================================
+TEST_CASE("WavetableBank samples tall images down to the table limit", "[wavetable]")
+{
+    TestPlanes planes(16, 300, [](int x, int y, int) { return static_cast<uint8_t>((x * 16 + y) & 0xff); });
+
+    WavetableBank bank;
+
+    SECTION("Rows beyond the limit are skipped evenly")
+    {
+        REQUIRE(bank.build(planes.view, WavetableAxis::Rows));
+        REQUIRE(bank.getNumTables() == WavetableBank::maxTables);
+        REQUIRE(bank.getNumLines() == 300);
+    }
+
+    SECTION("A cancelled build leaves no tables")
+    {
+        REQUIRE_FALSE(bank.build(planes.view, WavetableAxis::Rows, [] { return true; }));
+        REQUIRE_FALSE(bank.isBuilt());
+
+        std::vector<float> positions(8, 0.0f), red(8, 1.0f), green(8, 1.0f), blue(8, 1.0f);
+        double phase = 0.0;
+        bank.render(positions.data(), phase, 0.01, red.data(), green.data(), blue.data(), 8);
+        REQUIRE(red[0] == 0.0f);
+    }
+}